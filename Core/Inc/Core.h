@@ -470,6 +470,7 @@ CORE_API extern USubsystem*				GWindowManager;
 CORE_API extern TCHAR				    GErrorHist[4096];
 CORE_API extern TCHAR                   GTrue[64], GFalse[64], GYes[64], GNo[64], GNone[64], GIni[256];
 CORE_API extern TCHAR					GCdPath[];
+CORE_API extern TCHAR					GLinkerCachePath[];
 CORE_API extern	FLOAT					GSecondsPerCycle;
 CORE_API extern	FTime					GTempTime;
 CORE_API extern void					(*GTempFunc)(void*);
@@ -481,6 +482,7 @@ CORE_API extern QWORD					GPhysicalMemory;
 CORE_API extern DWORD                   GUglyHackFlags;
 CORE_API extern UBOOL					GIsScriptable;
 CORE_API extern UBOOL					GIsEditor;
+CORE_API extern UBOOL					GReproducibleSave;
 CORE_API extern UBOOL					GIsClient;
 CORE_API extern UBOOL					GIsServer;
 CORE_API extern UBOOL					GIsCriticalError;
@@ -290,9 +290,11 @@ public:
 	UBOOL Move( const TCHAR* Dest, const TCHAR* Src, UBOOL Replace=1, UBOOL EvenIfReadOnly=0, UBOOL Attributes=0 )
 	{
 		guard(FFileManagerWindows::Move);
-		//warning: MoveFileEx is broken on Windows 95 (Microsoft bug).
-		Delete( Dest, 0, 1 );
-		INT Result = TCHAR_CALL_OS( MoveFileW(Src,Dest), MoveFileA(TCHAR_TO_ANSI(Src),TCHAR_TO_ANSI(Dest)) );
+		// Replace the destination in one step, so it is never missing or half written.
+		if( Replace )
+			TCHAR_CALL_OS(SetFileAttributesW(Dest,FILE_ATTRIBUTE_NORMAL),SetFileAttributesA(TCHAR_TO_ANSI(Dest),FILE_ATTRIBUTE_NORMAL));
+		DWORD MoveFlags = MOVEFILE_COPY_ALLOWED | (Replace ? MOVEFILE_REPLACE_EXISTING : 0);
+		INT Result = TCHAR_CALL_OS( MoveFileExW(Src,Dest,MoveFlags), MoveFileExA(TCHAR_TO_ANSI(Src),TCHAR_TO_ANSI(Dest),MoveFlags) );
 		if( !Result )
 			debugf( NAME_Warning, TEXT("Error moving file '%ls' to '%ls'"), Src, Dest );
 		return Result!=0;
@@ -300,13 +302,13 @@ public:
 	}
 	SQWORD GetGlobalTime( const TCHAR* Filename )
 	{
-		//return grenwich mean time as expressed in nanoseconds since the creation of the universe.
-		//time is expressed in meters, so divide by the speed of light to obtain seconds.
-		//assumes the speed of light in a vacuum is constant.
-		//the file specified by Filename is assumed to be in your reference frame, otherwise you
-		//must transform the result by the path integral of the minkowski metric tensor in order to
-		//obtain the correct result.
-		return 0;
+		guard(FFileManagerWindows::GetGlobalTime);
+		// Last write time in 100ns units, or 0 if the file doesn't exist.
+		WIN32_FILE_ATTRIBUTE_DATA Data;
+		if( !TCHAR_CALL_OS(GetFileAttributesExW(Filename,GetFileExInfoStandard,&Data),GetFileAttributesExA(TCHAR_TO_ANSI(Filename),GetFileExInfoStandard,&Data)) )
+			return 0;
+		return ((SQWORD)Data.ftLastWriteTime.dwHighDateTime << 32) | Data.ftLastWriteTime.dwLowDateTime;
+		unguard;
 	}
 	UBOOL SetGlobalTime( const TCHAR* Filename )
 	{
@@ -76,6 +76,32 @@ struct CORE_API FObjectImport
 	friend FArchive& operator<<(FArchive& Ar, FObjectImport& I);
 };
 
+//
+// Identifies an import as seen from the linker that exports it, so the
+// export it resolved to can be remembered for every other importer.
+//
+struct FImportResolveKey
+{
+	FName			ClassPackage;
+	FName			ClassName;
+	FName			ObjectName;
+	INT				OuterIndex;		// Source export index of the outer, INDEX_NONE if top level, -2 if unconstrained.
+
+	FImportResolveKey()
+	{}
+	FImportResolveKey( FName InClassPackage, FName InClassName, FName InObjectName, INT InOuterIndex )
+	:	ClassPackage( InClassPackage ), ClassName( InClassName ), ObjectName( InObjectName ), OuterIndex( InOuterIndex )
+	{}
+	UBOOL operator==( const FImportResolveKey& Other ) const
+	{
+		return ObjectName==Other.ObjectName && ClassName==Other.ClassName && ClassPackage==Other.ClassPackage && OuterIndex==Other.OuterIndex;
+	}
+	friend DWORD GetTypeHash( const FImportResolveKey& Key )
+	{
+		return Key.ObjectName.GetIndex() + 7*Key.ClassName.GetIndex() + 31*Key.ClassPackage.GetIndex() + 131*Key.OuterIndex;
+	}
+};
+
 /*----------------------------------------------------------------------------
 	Items stored in Unrealfiles.
 ----------------------------------------------------------------------------*/
@@ -198,7 +224,9 @@ struct FPackageFileSummary
 
 	// Constructor.
 	FPackageFileSummary()
-		: Tag(0), FileVersion(0), PackageFlags(0), NameCount(0), NameOffset(0), ExportCount(0), ExportOffset(0), ImportCount(0), ImportOffset(0)
+		: Tag(0), FileVersion(0), TotalHeaderSize(0), PackageFlags(0), NameCount(0), NameOffset(0), ExportCount(0), ExportOffset(0), ImportCount(0), ImportOffset(0)
+		, DependsOffset(0), ImportExportGuidsOffset(INDEX_NONE), ImportGuidsCount(0), ExportGuidsCount(0), ThumbnailTableOffset(0)
+		, EngineVersion(0), CookedContentVersion(0), CompressionFlags(0), PackageSource(0)
 	{}
 
 #if 1 //LVer added by Legend on 4/12/2000
@@ -287,6 +315,7 @@ class CORE_API ULinkerLoad : public ULinker, public FArchive
 	INT						ExportHash[256];
 	TArray<FLazyLoader*>	LazyLoaders;
 	FArchive*				Loader;
+	TMap<FImportResolveKey,INT> ResolvedImports; // Export index each import of this package resolved to, shared by all importers.
 
 	#ifdef UTPG_MD5
 	FString       ShortFilename;
@@ -322,6 +351,11 @@ private:
 	void DetachExport( INT i );
 	ULinkerLoad* GetSourceLinker(INT iLinkerImport);
 
+	// Header cache.
+	FString GetHeaderCacheFilename();
+	UBOOL LoadHeaderCache();
+	void SaveHeaderCache();
+
 	// UObject interface.
 	void Serialize( FArchive& Ar );
 	void Destroy();
@@ -369,14 +403,16 @@ class ULinkerSave : public ULinker, public FArchive
 	NO_DEFAULT_CONSTRUCTOR(ULinkerSave);
 
 	// Variables.
-	FArchive* Saver;
+	FBufferArchive* Saver; // Whole package is built in memory and written by SaveToDisk.
 	TArray<INT> ObjectIndices;
 	TArray<INT> NameIndices;
 	TArray<TArray<INT> > DependsMap;
+	FMD5Context* ContentHash; // If set, receives every byte written.
 
 	// Constructor.
 	ULinkerSave( UObject* InParent, const TCHAR* InFilename );
 	void Destroy();
+	UBOOL SaveToDisk();
 
 	// FArchive interface.
 	INT MapName( FName* Name );
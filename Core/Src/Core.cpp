@@ -132,6 +132,7 @@ CORE_API TCHAR					GTrue[64]=TEXT("True");			/* Localized "true" text */
 CORE_API TCHAR					GFalse[64]=TEXT("False");		/* Localized "false" text */
 CORE_API TCHAR					GNone[64]=TEXT("None");			/* Localized "none" text */
 CORE_API TCHAR                  GCdPath[256]=TEXT("");			/* Cd path, if any */
+CORE_API TCHAR                  GLinkerCachePath[256]=TEXT("");	/* Linker header cache directory, empty if disabled */
 CORE_API TCHAR                  GIni[256]=TEXT("");			    /* Cd path, if any */
 CORE_API FLOAT					GSecondsPerCycle=1.0f;			/* Seconds per CPU cycle for this PC */
 CORE_API FLOAT					GCorrection= 0.0;				// Correction
@@ -145,6 +146,7 @@ CORE_API QWORD					GPhysicalMemory=16384*1024;		/* Bytes of physical memory in t
 CORE_API DWORD                  GUglyHackFlags=0;               /* Flags for passing around globally hacked stuff */
 CORE_API UBOOL					GIsScriptable=0;				/* Whether script execution is allowed */
 CORE_API UBOOL					GIsEditor=0;					/* Whether engine was launched for editing */
+CORE_API UBOOL					GReproducibleSave=0;			/* Whether saved packages must be byte-identical for identical input */
 CORE_API UBOOL					GIsClient=0;					/* Whether engine was launched as a client */
 CORE_API UBOOL					GIsServer=0;					/* Whether engine was launched as a server, true if GIsClient */
 CORE_API UBOOL					GIsCriticalError=0;				/* An appError() has occured */
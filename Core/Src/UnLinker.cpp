@@ -20,6 +20,74 @@ inline INT HashNames( FName A, FName B, FName C )
 
 static UObject* _LoadingObj = NULL;
 
+/*-----------------------------------------------------------------------------
+	Linker header cache archives.
+-----------------------------------------------------------------------------*/
+
+#define LINKER_CACHE_TAG		0x3143484C /* LHC1 */
+#define LINKER_CACHE_VERSION	1
+
+//
+// Writes cached tables, storing names as indices into a packed string pool.
+// The pool starts with the package's own name table so NameMap can be
+// restored positionally; names only produced by number suffixes are appended.
+//
+class FLinkerCacheWriter : public FBufferWriter
+{
+public:
+	TArray<FName> Pool;
+	TMap<FName,INT> PoolIndices;
+
+	FLinkerCacheWriter( TArray<BYTE>& InBytes, const TArray<FName>& NameMap, INT InVer )
+	: FBufferWriter( InBytes )
+	{
+		ArVer = InVer;
+		Pool = NameMap;
+		for( INT i=NameMap.Num()-1; i>=0; i-- )
+			PoolIndices.Set( NameMap(i), i );
+	}
+	FArchive& operator<<( FName& Name )
+	{
+		INT* Found = PoolIndices.Find( Name );
+		INT Index = Found ? *Found : INDEX_NONE;
+		if( Index==INDEX_NONE )
+		{
+			Index = Pool.AddItem( Name );
+			PoolIndices.Set( Name, Index );
+		}
+		return *this << Index;
+	}
+};
+
+//
+// Reads cached tables back, resolving pool indices to names.
+//
+class FLinkerCacheReader : public FBufferReader
+{
+public:
+	TArray<FName> Pool;
+
+	FLinkerCacheReader( const TArray<BYTE>& InBytes, INT InVer )
+	: FBufferReader( InBytes )
+	{
+		ArVer = InVer;
+		ArIsTrans = 0;
+	}
+	FArchive& operator<<( FName& Name )
+	{
+		INT Index = INDEX_NONE;
+		*this << Index;
+		if( Pool.IsValidIndex(Index) )
+			Name = Pool(Index);
+		else
+		{
+			Name = NAME_None;
+			ArIsError = 1;
+		}
+		return *this;
+	}
+};
+
 /*-----------------------------------------------------------------------------
 	FObjectExport.
 -----------------------------------------------------------------------------*/
@@ -341,49 +409,55 @@ ULinkerLoad::ULinkerLoad( UObject* InParent, const TCHAR* InFilename, DWORD InLo
 	ExportMap   .Empty( Summary.ExportCount   );
 	NameMap		.Empty( Summary.NameCount     );
 
-	// Load and map names.
-	guard(LoadNames);
-	if( Summary.NameCount > 0 )
+	// Use the cached tables if this exact file has been seen before.
+	if( !LoadHeaderCache() )
 	{
-		Seek( Summary.NameOffset );
-		for( INT i=0; i<Summary.NameCount; i++ )
+		// Load and map names.
+		guard(LoadNames);
+		if( Summary.NameCount > 0 )
 		{
-			// Read the name entry from the file.
-			FNameEntry NameEntry;
+			Seek( Summary.NameOffset );
+			for( INT i=0; i<Summary.NameCount; i++ )
+			{
+				// Read the name entry from the file.
+				FNameEntry NameEntry;
 
-            // explicitly init fields to prevent Valgrind whining. --ryan.
-            NameEntry.Index = 0;
-            NameEntry.Flags = 0;
-            NameEntry.HashNext = NULL;
-            appMemzero(NameEntry.Name, sizeof(NameEntry.Name));
+				// explicitly init fields to prevent Valgrind whining. --ryan.
+				NameEntry.Index = 0;
+				NameEntry.Flags = 0;
+				NameEntry.HashNext = NULL;
+				appMemzero(NameEntry.Name, sizeof(NameEntry.Name));
 
-			*this << NameEntry;
+				*this << NameEntry;
 
-			// Add it to the name table if it's needed in this context.
-			NameMap.AddItem( FName( NameEntry.Name, FNAME_Add ) );
+				// Add it to the name table if it's needed in this context.
+				NameMap.AddItem( FName( NameEntry.Name, FNAME_Add ) );
+			}
 		}
-	}
-	unguard;
+		unguard;
 
-	// Load import map.
-	guard(LoadImportMap);
-	if( Summary.ImportCount > 0 )
-	{
-		Seek( Summary.ImportOffset );
-		for (INT i = 0; i < Summary.ImportCount; i++)
-			*this << *new(ImportMap)FObjectImport;
-	}
-	unguard;
+		// Load import map.
+		guard(LoadImportMap);
+		if( Summary.ImportCount > 0 )
+		{
+			Seek( Summary.ImportOffset );
+			for (INT i = 0; i < Summary.ImportCount; i++)
+				*this << *new(ImportMap)FObjectImport;
+		}
+		unguard;
 
-	// Load export map.
-	guard(LoadExportMap);
-	if( Summary.ExportCount > 0 )
-	{
-		Seek( Summary.ExportOffset );
-		for( INT i=0; i<Summary.ExportCount; i++ )
-			*this << *new(ExportMap)FObjectExport;
+		// Load export map.
+		guard(LoadExportMap);
+		if( Summary.ExportCount > 0 )
+		{
+			Seek( Summary.ExportOffset );
+			for( INT i=0; i<Summary.ExportCount; i++ )
+				*this << *new(ExportMap)FObjectExport;
+		}
+		unguard;
+
+		SaveHeaderCache();
 	}
-	unguard;
 
 	// Create export hash.
 	//warning: Relies on import & export tables, so must be done here.
@@ -410,6 +484,165 @@ ULinkerLoad::ULinkerLoad( UObject* InParent, const TCHAR* InFilename, DWORD InLo
 	unguard;
 }
 
+/*----------------------------------------------------------------------------
+	ULinkerLoad header cache.
+----------------------------------------------------------------------------*/
+
+//
+// The cache file holding this package's decoded tables.
+//
+FString ULinkerLoad::GetHeaderCacheFilename()
+{
+	guard(ULinkerLoad::GetHeaderCacheFilename);
+	return FString::Printf(TEXT("%ls") PATH_SEPARATOR TEXT("%ls_%08X.lhc"), GLinkerCachePath, LinkerRoot->GetName(), appStrCrcCaps(*Filename));
+	unguard;
+}
+
+//
+// Restore the name, import and export tables from the header cache.
+// The entry is only accepted if path, size, timestamp and package guid
+// all match the file that was just opened. Returns 0 on a miss.
+//
+UBOOL ULinkerLoad::LoadHeaderCache()
+{
+	guard(ULinkerLoad::LoadHeaderCache);
+	if( !GLinkerCachePath[0] )
+		return 0;
+
+	// Pull the whole entry in with a single read.
+	FString CacheFilename = GetHeaderCacheFilename();
+	FArchive* CacheFile = GFileManager->CreateFileReader( *CacheFilename );
+	if( !CacheFile )
+		return 0;
+	TArray<BYTE> Data;
+	Data.Add( CacheFile->TotalSize() );
+	if( Data.Num() )
+		CacheFile->Serialize( &Data(0), Data.Num() );
+	UBOOL ReadOk = CacheFile->Close();
+	delete CacheFile;
+	if( !ReadOk || Data.Num()<(INT)(2*sizeof(INT)) )
+		return 0;
+
+	// Validate file identity.
+	FLinkerCacheReader Ar( Data, ArVer );
+	INT Tag=0, Version=0, FileSize=0, PayloadSize=0;
+	SQWORD FileTime=0;
+	FString Path;
+	FGuid Guid;
+	Ar << Tag << Version;
+	if( Tag!=LINKER_CACHE_TAG || Version!=LINKER_CACHE_VERSION )
+		return 0;
+	Ar << Path << FileSize << FileTime << Guid << PayloadSize;
+	if
+	(	Path!=Filename
+	||	FileSize!=Loader->TotalSize()
+	||	FileTime!=GFileManager->GetGlobalTime(*Filename)
+	||	Guid!=Summary.Guid
+	||	PayloadSize!=Data.Num()-Ar.Tell() )
+		return 0;
+
+	// Restore the string pool.
+	INT PoolCount=0, PoolChars=0;
+	Ar << PoolCount << PoolChars;
+	if( PoolCount<Summary.NameCount || PoolChars<0 || PoolChars*(INT)sizeof(TCHAR)>Data.Num()-Ar.Tell() )
+		return 0;
+	const TCHAR* Str = (const TCHAR*)&Data(Ar.Tell());
+	const TCHAR* End = Str + PoolChars;
+	if( PoolChars && End[-1]!=0 )
+		return 0;
+	Ar.Seek( Ar.Tell() + PoolChars*sizeof(TCHAR) );
+	Ar.Pool.Empty( PoolCount );
+	for( INT i=0; i<PoolCount; i++ )
+	{
+		if( Str>=End )
+			return 0;
+		Ar.Pool.AddItem( FName( Str, FNAME_Add ) );
+		Str += appStrlen(Str) + 1;
+	}
+
+	// Restore the tables.
+	INT ImportCount=0, ExportCount=0;
+	NameMap.Add( Summary.NameCount );
+	for( INT i=0; i<Summary.NameCount; i++ )
+		NameMap(i) = Ar.Pool(i);
+	Ar << ImportCount;
+	if( ImportCount==Summary.ImportCount )
+		for( INT i=0; i<ImportCount; i++ )
+			Ar << *new(ImportMap)FObjectImport;
+	Ar << ExportCount;
+	if( ExportCount==Summary.ExportCount )
+		for( INT i=0; i<ExportCount; i++ )
+			Ar << *new(ExportMap)FObjectExport;
+	if( Ar.IsError() || ImportCount!=Summary.ImportCount || ExportCount!=Summary.ExportCount || !Ar.AtEnd() )
+	{
+		debugf( NAME_Warning, TEXT("Discarding corrupt linker cache '%ls'"), *CacheFilename );
+		NameMap.Empty( Summary.NameCount );
+		ImportMap.Empty( Summary.ImportCount );
+		ExportMap.Empty( Summary.ExportCount );
+		return 0;
+	}
+	return 1;
+	unguard;
+}
+
+//
+// Store the freshly loaded tables in the header cache.
+//
+void ULinkerLoad::SaveHeaderCache()
+{
+	guard(ULinkerLoad::SaveHeaderCache);
+	if( !GLinkerCachePath[0] || ArIsError )
+		return;
+
+	// Tables first, since they may grow the string pool.
+	TArray<BYTE> Tables;
+	FLinkerCacheWriter TableAr( Tables, NameMap, ArVer );
+	INT ImportCount = ImportMap.Num(), ExportCount = ExportMap.Num();
+	TableAr << ImportCount;
+	for( INT i=0; i<ImportCount; i++ )
+		TableAr << ImportMap(i);
+	TableAr << ExportCount;
+	for( INT i=0; i<ExportCount; i++ )
+		TableAr << ExportMap(i);
+
+	// Pack the pool as consecutive null-terminated strings.
+	TArray<TCHAR> PoolChars;
+	for( INT i=0; i<TableAr.Pool.Num(); i++ )
+	{
+		const TCHAR* Str = *TableAr.Pool(i);
+		INT Len = appStrlen(Str) + 1;
+		appMemcpy( &PoolChars(PoolChars.Add(Len)), Str, Len*sizeof(TCHAR) );
+	}
+
+	TArray<BYTE> Payload;
+	FBufferWriter PayloadAr( Payload );
+	INT PoolCount = TableAr.Pool.Num(), PoolNum = PoolChars.Num();
+	PayloadAr << PoolCount << PoolNum;
+	if( PoolNum )
+		PayloadAr.Serialize( &PoolChars(0), PoolNum*sizeof(TCHAR) );
+	if( Tables.Num() )
+		PayloadAr.Serialize( &Tables(0), Tables.Num() );
+
+	// Write it out in one go.
+	GFileManager->MakeDirectory( GLinkerCachePath, 1 );
+	FString CacheFilename = GetHeaderCacheFilename();
+	FArchive* CacheFile = GFileManager->CreateFileWriter( *CacheFilename );
+	if( !CacheFile )
+	{
+		debugf( NAME_Warning, TEXT("Failed to create linker cache '%ls'"), *CacheFilename );
+		return;
+	}
+	INT Tag = LINKER_CACHE_TAG, Version = LINKER_CACHE_VERSION;
+	INT FileSize = Loader->TotalSize(), PayloadSize = Payload.Num();
+	SQWORD FileTime = GFileManager->GetGlobalTime( *Filename );
+	*CacheFile << Tag << Version << Filename << FileSize << FileTime << Summary.Guid << PayloadSize;
+	CacheFile->Serialize( &Payload(0), Payload.Num() );
+	if( !CacheFile->Close() )
+		GFileManager->Delete( *CacheFilename );
+	delete CacheFile;
+	unguard;
+}
+
 void ULinkerLoad::Verify()
 {
 	guard(ULinkerLoad::Verify);
@@ -592,38 +825,31 @@ void ULinkerLoad::VerifyImport( INT i )
 	INT iHash = HashNames( Import.ObjectName, Import.ClassName, Import.ClassPackage) & (ARRAY_COUNT(ExportHash)-1);
 	if( Import.SourceLinker )
 	{
-		for( INT j=Import.SourceLinker->ExportHash[iHash]; j!=INDEX_NONE; j=Import.SourceLinker->ExportMap(j)._iHashNext )
+		// Other packages importing the same object have usually resolved it already.
+		INT OuterIndex = -2;
+		if( Import.PackageIndex<0 && ImportMap(-Import.PackageIndex-1).SourceLinker )
+			OuterIndex = ImportMap(-Import.PackageIndex-1).SourceIndex;
+		FImportResolveKey Key( Import.ClassPackage, Import.ClassName, Import.ObjectName, OuterIndex );
+		INT* Resolved = Import.SourceLinker->ResolvedImports.Find( Key );
+		if( Resolved )
+			Import.SourceIndex = *Resolved;
+		else
 		{
-			FObjectExport& Source = Import.SourceLinker->ExportMap( j );
-			if
-			(	(Source.ObjectName	                          ==Import.ObjectName               )
-			&&	(Import.SourceLinker->GetExportClassName   (j)==Import.ClassName                )
-			&&  (Import.SourceLinker->GetExportClassPackage(j)==Import.ClassPackage) )
+			for( INT j=Import.SourceLinker->ExportHash[iHash]; j!=INDEX_NONE; j=Import.SourceLinker->ExportMap(j)._iHashNext )
 			{
-				if( Import.PackageIndex<0 )
+				FObjectExport& Source = Import.SourceLinker->ExportMap( j );
+				if
+				(	(Source.ObjectName	                          ==Import.ObjectName               )
+				&&	(Import.SourceLinker->GetExportClassName   (j)==Import.ClassName                )
+				&&  (Import.SourceLinker->GetExportClassPackage(j)==Import.ClassPackage) )
 				{
-					FObjectImport& ParentImport = ImportMap(-Import.PackageIndex-1);
-					if( ParentImport.SourceLinker )
-					{
-						if( ParentImport.SourceIndex==INDEX_NONE )
-						{
-							if( Source.PackageIndex!=0 )
-							{
-								continue;
-							}
-						}
-						else if( ParentImport.SourceIndex+1 != Source.PackageIndex )
-						{
-							if( Source.PackageIndex!=0 )
-							{
-								continue;
-							}
-						}
-					}
+					if( OuterIndex!=-2 && OuterIndex+1!=Source.PackageIndex && Source.PackageIndex!=0 )
+						continue;
+					Import.SourceIndex = j;
+					break;
 				}
-				Import.SourceIndex = j;
-				break;
 			}
+			Import.SourceLinker->ResolvedImports.Set( Key, Import.SourceIndex );
 		}
 	}
 
@@ -1107,11 +1333,10 @@ ULinkerLoad::Serialize( void* V, INT Length )
 ULinkerSave::ULinkerSave( UObject* InParent, const TCHAR* InFilename )
 :	ULinker( InParent, InFilename )
 ,	Saver( NULL )
+,	ContentHash( NULL )
 {
-	// Create file saver.
-	Saver = GFileManager->CreateFileWriter( InFilename, 0, GThrow );
-	if( !Saver )
-		appThrowf( TEXT("Error opening file") );
+	// Create in-memory saver, written out in one go by SaveToDisk.
+	Saver = new FBufferArchive;
 
 	// Set main summary info.
 	Summary.Tag           = PACKAGE_FILE_TAG;
@@ -1139,6 +1364,23 @@ ULinkerSave::ULinkerSave( UObject* InParent, const TCHAR* InFilename )
 	Success=1;
 }
 
+//
+// Write the finished package to Filename with a single write.
+//
+UBOOL ULinkerSave::SaveToDisk()
+{
+	guard(ULinkerSave::SaveToDisk);
+	FArchive* FileAr = GFileManager->CreateFileWriter( *Filename, 0, GThrow );
+	if( !FileAr )
+		appThrowf( TEXT("Error opening file") );
+	if( Saver->Num() )
+		FileAr->Serialize( &(*Saver)(0), Saver->Num() );
+	UBOOL Result = FileAr->Close();
+	delete FileAr;
+	return Result;
+	unguard;
+}
+
 void
 ULinkerSave::Destroy()
 {
@@ -1198,6 +1440,8 @@ INT ULinkerSave::Tell()
 
 void ULinkerSave::Serialize( void* V, INT Length )
 {
+	if( ContentHash )
+		appMD5Update( ContentHash, (BYTE*)V, Length );
 	Saver->Serialize( V, Length );
 }
 
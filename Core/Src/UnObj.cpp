@@ -1768,6 +1768,7 @@ void UObject::ResetLoaders( UObject* Pkg, UBOOL DynamicOnly, UBOOL ForceLazyLoad
 			// Fully reset the loader.
 			if( ForceLazyLoad )
 				Linker->DetachAllLazyLoaders( 1 );
+			Linker->ResolvedImports.Empty();
 		}
 		else
 		{
@@ -1937,14 +1938,24 @@ INT CDECL LinkerNameSort(const FName* A, const FName* B )
 	return appStricmp(**A, **B);
 	//return GTempSave->MapName(B) - GTempSave->MapName(A);
 }
+// Break name ties by full path, so the order never depends on object iteration order.
+static INT LinkerPathSort( UObject* A, UObject* B )
+{
+	INT Result = appStricmp(A->GetClass()->GetName(), B->GetClass()->GetName());
+	if (Result == 0)
+		Result = appStricmp(*A->GetPathNameSafe(), *B->GetPathNameSafe());
+	return Result;
+}
 INT CDECL LinkerImportSort( const FObjectImport* A, const FObjectImport* B )
 {
 	INT Result = 0;
 	if (A->XObject == NULL)
-		Result = 1;
+		Result = (B->XObject == NULL) ? 0 : 1;
 	else if (B->XObject == NULL)
 		Result = -1;
 	else Result = appStricmp(A->XObject->GetName(), B->XObject->GetName());
+	if (Result == 0 && A->XObject && B->XObject)
+		Result = LinkerPathSort(A->XObject, B->XObject);
 
 	return Result;
 	//return GTempSave->MapObject(((FObjectImport*)B)->XObject) - GTempSave->MapObject(((FObjectImport*)A)->XObject);
@@ -1953,10 +1964,12 @@ INT CDECL LinkerExportSort( const FObjectExport* A, const FObjectExport* B )
 {
 	INT Result = 0;
 	if (A->_Object == NULL)
-		Result = 1;
+		Result = (B->_Object == NULL) ? 0 : 1;
 	else if (B->_Object == NULL)
 		Result = -1;
 	else Result = appStricmp(A->_Object->GetName(), B->_Object->GetName());
+	if (Result == 0 && A->_Object && B->_Object)
+		Result = LinkerPathSort(A->_Object, B->_Object);
 	return Result;
 	//return GTempSave->MapObject(((FObjectExport*)B)->_Object) - GTempSave->MapObject(((FObjectExport*)A)->_Object);
 }
@@ -2074,6 +2087,8 @@ class FExportReferenceSorter : public FArchive
 
 			ReferencedObjects.AddItem(CoreClass);
 			ReferencedObjects.AddItem(CoreClass->GetDefaultObject());
+			ReferencedSet.Set(CoreClass);
+			ReferencedSet.Set(CoreClass->GetDefaultObject());
 		}
 
 		for (INT CoreClassIndex = 0; CoreClassIndex < CoreClasses.Num(); CoreClassIndex++)
@@ -2094,7 +2109,7 @@ class FExportReferenceSorter : public FArchive
 	void AddReferencedObject(UObject* Object, INT InsertIndex)
 	{
 		guard(FExportReferenceSorter::AddReferencedObject);
-		if (Object != NULL && ReferencedObjects.FindItemIndex(Object)==INDEX_NONE)
+		if (Object != NULL && ReferencedSet.Set(Object))
 		{
 			ReferencedObjects.Insert(InsertIndex);
 			ReferencedObjects(InsertIndex) = Object;
@@ -2262,6 +2277,9 @@ public:
 	{
 		guard(FExportReferenceSorter::Clear);
 		ReferencedObjects.Remove(CoreReferencesOffset, ReferencedObjects.Num() - CoreReferencesOffset);
+		ReferencedSet.Empty();
+		for (INT RefIndex = 0; RefIndex < ReferencedObjects.Num(); RefIndex++)
+			ReferencedSet.Set(ReferencedObjects(RefIndex));
 		unguard;
 	}
 
@@ -2526,7 +2544,7 @@ public:
 
 						// we should be the only one adding CDO's to the list, so this assertion is to catch cases where someone else
 						// has added the CDO to the list (as it will probably be in the wrong spot).
-						check(ReferencedObjects.FindItemIndex(CDO) == INDEX_NONE || CoreClasses.FindItemIndex(ClassObject) != INDEX_NONE);
+						check(!ReferencedSet.Find(CDO) || CoreClasses.FindItemIndex(ClassObject) != INDEX_NONE);
 						AddReferencedObject(CDO, ClassIndex + 1);
 					}
 				}
@@ -2573,6 +2591,11 @@ private:
 	 */
 	TArray<UObject*> ReferencedObjects;
 
+	/**
+	 * Same objects as ReferencedObjects, for constant time membership tests.
+	 */
+	TSingleMap<UObject*> ReferencedSet;
+
 	/**
 	 * Controls whether to process UField objects encountered during serialization of an object.
 	 */
@@ -3037,6 +3060,7 @@ class FArchiveSaveTagImports : public FArchive
 public:
 	DWORD ContextFlags;
 	TArray<UObject*> Dependencies;
+	TSingleMap<UObject*> DependencySet;
 
 	FArchiveSaveTagImports( ULinkerSave* InLinker, DWORD InContextFlags )
 	: ContextFlags( InContextFlags ), Linker( InLinker )
@@ -3053,25 +3077,30 @@ public:
 			if( !(Obj->GetFlags() & RF_Transient) || (Obj->GetFlags() & RF_Public) )
 			{
 				Linker->ObjectIndices(Obj->GetIndex())++;
-				if( !(Obj->GetFlags() & RF_TagExp ) )
+
+				// remember it as a dependency, unless it's a top level pacakge or native;
+				// other exports count too, so the depends map covers the whole load order.
+				UBOOL bIsTopLevelPackage = Obj->GetOuter() == NULL && Obj->IsA(UPackage::StaticClass());
+				if (!bIsTopLevelPackage)
 				{
-					// remember it as a dependency, unless it's a top level pacakge or native
-					UBOOL bIsTopLevelPackage = Obj->GetOuter() == NULL && Obj->IsA(UPackage::StaticClass());
-					if (!bIsTopLevelPackage)
+					UBOOL bIsNative = Obj->HasAnyFlags(RF_Native);
+					if (!bIsNative)
 					{
-						UBOOL bIsNative = Obj->HasAnyFlags(RF_Native);
-						if (!bIsNative)
-						{
-							UClass* COuter = FindOuter<UClass>(Obj->GetOuter());
-							if (COuter && COuter->HasAnyFlags(RF_Native))
-								bIsNative = TRUE;
-						}
+						UClass* COuter = FindOuter<UClass>(Obj->GetOuter());
+						if (COuter && COuter->HasAnyFlags(RF_Native))
+							bIsNative = TRUE;
+					}
 
-						// only add valid objects
-						if (!bIsNative)
-							Dependencies.AddUniqueItem(Obj);
+					// only add valid objects
+					if (!bIsNative && !DependencySet.Find(Obj))
+					{
+						DependencySet.Set(Obj);
+						Dependencies.AddItem(Obj);
 					}
+				}
 
+				if( !(Obj->GetFlags() & RF_TagExp ) )
+				{
 					Obj->SetFlags( RF_TagImp );
 					if( !(Obj->GetFlags() & RF_NotForEdit  ) ) Obj->SetFlags(RF_LoadForEdit);
 					if( !(Obj->GetFlags() & RF_NotForClient) ) Obj->SetFlags(RF_LoadForClient);
@@ -3108,6 +3137,10 @@ UBOOL UObject::SavePackage( UObject* InOuter, UObject* Base, DWORD TopLevelFlags
 	check(InOuter);
 	check(Filename);
 
+	// A reproducible save must not depend on the previous build, so never conform to it.
+	if( GReproducibleSave )
+		Conform = NULL;
+
 	// Make temp file.
 	TCHAR TempFilename[256];
 	//appStrcpy( TempFilename, Filename );
@@ -3178,6 +3211,7 @@ UBOOL UObject::SavePackage( UObject* InOuter, UObject* Base, DWORD TopLevelFlags
 					appErrorf( TEXT("Trying to import Transient object %ls"), It->GetFullName() );
 
 				// add the list of dependencies to the dependency map
+				Ar.Dependencies.RemoveItem(*It);
 				ObjectDependencies.Set(*It, Ar.Dependencies);
 			}
 		}
@@ -3219,7 +3253,14 @@ UBOOL UObject::SavePackage( UObject* InOuter, UObject* Base, DWORD TopLevelFlags
 
 		// Write fixed-length file summary to overwrite later.
 		guard(SaveSummary);
-		if( Conform )
+		if( GReproducibleSave )
+		{
+			// Guid is derived from the content once everything is written, and the
+			// generation history is dropped so rebuilding never changes the output.
+			Linker->Summary.Guid        = FGuid(0,0,0,0);
+			Linker->Summary.Generations = TArray<FGenerationInfo>();
+		}
+		else if( Conform )
 		{
 			// Conform to previous generation of file.
 			debugf( NAME_DevSave, TEXT("Conformal save, relative to: %ls, Generation %i"), *Conform->Filename, Conform->Summary.Generations.Num()+1 );
@@ -3237,6 +3278,14 @@ UBOOL UObject::SavePackage( UObject* InOuter, UObject* Base, DWORD TopLevelFlags
 		*Linker << Linker->Summary;
 		unguard;
 
+		// Hash everything following the summary.
+		FMD5Context ContentHash;
+		if( GReproducibleSave )
+		{
+			appMD5Init( &ContentHash );
+			Linker->ContentHash = &ContentHash;
+		}
+
 		// Build NameMap.
 		guard(BuildNameMap);
 		Linker->Summary.NameOffset = Linker->Tell();
@@ -3479,6 +3528,13 @@ UBOOL UObject::SavePackage( UObject* InOuter, UObject* Base, DWORD TopLevelFlags
 		// Rewrite updated file summary.
 		guard(RewriteSummary);
 		GWarn->StatusUpdatef( 0, 0, TEXT("%ls"), TEXT("Closing") );
+		if( Linker->ContentHash )
+		{
+			BYTE Digest[16];
+			Linker->ContentHash = NULL;
+			appMD5Final( Digest, &ContentHash );
+			appMemcpy( &Linker->Summary.Guid, Digest, sizeof(FGuid) );
+		}
 		Linker->Summary.Generations.Last().ExportCount = Linker->Summary.ExportCount;
 		Linker->Summary.Generations.Last().NameCount   = Linker->Summary.NameCount;
 		Linker->Summary.Generations.Last().NetObjectCount = Linker->Summary.ExportCount;
@@ -3487,6 +3543,12 @@ UBOOL UObject::SavePackage( UObject* InOuter, UObject* Base, DWORD TopLevelFlags
 		*Linker << Linker->Summary;
 		unguard;
 
+		// Flush the package to the temporary file.
+		guard(WriteFile);
+		if( !Linker->SaveToDisk() )
+			appThrowf( TEXT("Error writing '%ls'"), TempFilename );
+		unguard;
+
 		Success = 1;
 	}
 	catch( const TCHAR* Msg )
@@ -42,6 +42,67 @@ static void SkipWhitespace(const TCHAR*& Str)
 	}
 }
 
+//
+// Plain numeric literals.
+//
+// Default properties are dominated by short literals such as 0, -1 or 0.5, which both the
+// direct and the ParsePropertyValue import paths only ever hand to appAtoi/appAtof. These
+// scanners convert them in place and return the end of the literal, or NULL whenever the
+// text needs the general path (hex, exponents, consts, expressions, trailing spaces...).
+//
+static inline UBOOL IsLiteralTerminator(TCHAR c)
+{
+	return c == 0 || c == ',' || c == ')';
+}
+static const TCHAR* ParseIntLiteral(const TCHAR* Buffer, INT& Result)
+{
+	const TCHAR* S = Buffer;
+	const UBOOL bNegative = (*S == '-');
+	if (*S == '+' || *S == '-')
+		++S;
+
+	// At most 9 digits, so the value can't overflow.
+	const TCHAR* Digits = S;
+	INT Value = 0;
+	while (*S >= '0' && *S <= '9' && (S - Digits) < 9)
+		Value = Value * 10 + (*S++ - '0');
+	if (S == Digits || !IsLiteralTerminator(*S))
+		return NULL;
+	Result = bNegative ? -Value : Value;
+	return S;
+}
+static const TCHAR* ParseFloatLiteral(const TCHAR* Buffer, FLOAT& Result)
+{
+	static const DOUBLE Pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+
+	const TCHAR* S = Buffer;
+	const UBOOL bNegative = (*S == '-');
+	if (*S == '+' || *S == '-')
+		++S;
+
+	QWORD Mantissa = 0;
+	INT NumDigits = 0, NumFraction = 0;
+	for (; *S >= '0' && *S <= '9'; ++S, ++NumDigits)
+		Mantissa = Mantissa * 10 + (*S - '0');
+	if (*S == '.')
+	{
+		for (++S; *S >= '0' && *S <= '9'; ++S, ++NumFraction)
+			Mantissa = Mantissa * 10 + (*S - '0');
+		if (*S == 'f')
+			++S;
+	}
+
+	// With at most 15 significant digits both the mantissa and the power of ten are exact doubles,
+	// so the single division rounds the same way appAtof does.
+	if ((NumDigits + NumFraction) == 0 || (NumDigits + NumFraction) > 15 || !IsLiteralTerminator(*S))
+		return NULL;
+	DOUBLE Value = (DOUBLE)(SQWORD)Mantissa;
+	if (NumFraction)
+		Value /= Pow10[NumFraction];
+	Result = (FLOAT)(bNegative ? -Value : Value);
+	return S;
+}
+
 //
 // Parse a token.
 //
@@ -546,6 +607,30 @@ const TCHAR* UByteProperty::ImportText(const TCHAR* Buffer, BYTE* Data, INT Port
 				return Buffer;
 			}
 		}
+
+		// Plain identifiers are looked up straight from the buffer.
+		if (appIsAlpha(*Buffer) || *Buffer == '_')
+		{
+			TCHAR Ident[64];
+			INT Len = 0;
+			while (isNameChar(Buffer[Len]) && Len < (ARRAY_COUNT(Ident) - 1))
+			{
+				Ident[Len] = Buffer[Len];
+				++Len;
+			}
+			if (!isNameChar(Buffer[Len]))
+			{
+				Ident[Len] = 0;
+				FName EnumName(Ident, FNAME_Find);
+				INT EnumIndex = 0;
+				if (EnumName != NAME_None && Enum->Names.FindItem(EnumName, EnumIndex))
+				{
+					*(BYTE*)Data = EnumIndex;
+					return Buffer + Len;
+				}
+				return NULL;
+			}
+		}
 		FString Temp;
 		Buffer = ReadToken(GetFullName(), Buffer, Temp);
 		if (!Buffer)
@@ -562,6 +647,16 @@ const TCHAR* UByteProperty::ImportText(const TCHAR* Buffer, BYTE* Data, INT Port
 		}
 		return NULL;
 	}
+	if (appIsDigit(*Buffer))
+	{
+		INT Value;
+		const TCHAR* End = ParseIntLiteral(Buffer, Value);
+		if (End)
+		{
+			*(BYTE*)Data = (BYTE)Value;
+			return End;
+		}
+	}
 	if ((PortFlags & PPF_ExecImport) && _ImportObject)
 	{
 		INT ResultValue;
@@ -792,6 +887,13 @@ void UIntProperty::ExportTextItem(FString& ValueStr, BYTE* PropertyValue, BYTE*
 const TCHAR* UIntProperty::ImportText(const TCHAR* Buffer, BYTE* Data, INT PortFlags) const
 {
 	guard(UIntProperty::ImportText);
+	INT Value;
+	const TCHAR* End = ParseIntLiteral(Buffer, Value);
+	if (End)
+	{
+		*(INT*)Data = Value;
+		return End;
+	}
 	if ((PortFlags & PPF_ExecImport) && _ImportObject)
 	{
 		if (!_ImportObject->GetDefaultObject()->ParsePropertyValue(Data, &Buffer, 1))
@@ -1013,6 +1115,9 @@ void UFloatProperty::ExportTextItem(FString& ValueStr, BYTE* PropertyValue, BYTE
 const TCHAR* UFloatProperty::ImportText(const TCHAR* Buffer, BYTE* Data, INT PortFlags) const
 {
 	guard(UFloatProperty::ImportText);
+	const TCHAR* End = ParseFloatLiteral(Buffer, *(FLOAT*)Data);
+	if (End)
+		return End;
 	if ((PortFlags & PPF_ExecImport) && _ImportObject)
 	{
 		if (!_ImportObject->GetDefaultObject()->ParsePropertyValue(Data, &Buffer, 0))
@@ -2460,9 +2565,87 @@ static UBOOL IsPropertyValueSpecified(const TCHAR* Buffer)
 	return Buffer && *Buffer && *Buffer != TCHAR(',') && *Buffer != TCHAR(')');
 }
 
+//
+// Imports (Key=Literal,...) into structs made only of int, float and plain byte members,
+// such as Vector, Rotator and Color, without building key strings or FNames.
+// Returns NULL if the text needs the general path; members may have been written by then,
+// but the general path assigns every key it is given again.
+//
+static const TCHAR* ImportNumericStruct(UStruct* Struct, const TCHAR* Buffer, BYTE* Data)
+{
+	UProperty* Members[8];
+	INT NumMembers = 0;
+	for (TFieldIterator<UProperty> It(Struct); It; ++It)
+	{
+		UProperty* Property = *It;
+		if (NumMembers == ARRAY_COUNT(Members) || Property->ArrayDim != 1)
+			return NULL;
+		if (!Property->IsA(UFloatProperty::StaticClass()) && !Property->IsA(UIntProperty::StaticClass())
+			&& !(Property->IsA(UByteProperty::StaticClass()) && !((UByteProperty*)Property)->Enum))
+			return NULL;
+		Members[NumMembers++] = Property;
+	}
+	if (!NumMembers || *Buffer++ != '(')
+		return NULL;
+
+	while (1)
+	{
+		// Get key name.
+		while (*Buffer == ' ' || *Buffer == '\t')
+			++Buffer;
+		const TCHAR* Key = Buffer;
+		while (appIsAlnum(*Buffer) || *Buffer == '_')
+			++Buffer;
+		const INT KeyLen = Buffer - Key;
+		while (*Buffer == ' ' || *Buffer == '\t')
+			++Buffer;
+		if (!KeyLen || *Buffer++ != '=')
+			return NULL;
+		while (*Buffer == ' ' || *Buffer == '\t')
+			++Buffer;
+
+		// Match it the way FName compares, first member wins.
+		UProperty* Property = NULL;
+		for (INT i = 0; i < NumMembers && !Property; ++i)
+		{
+			const TCHAR* MemberName = *Members[i]->GetFName();
+			if (appStrnicmp(MemberName, Key, KeyLen) == 0 && MemberName[KeyLen] == 0)
+				Property = Members[i];
+		}
+		if (!Property)
+			return NULL;
+
+		BYTE* pData = Data + Property->Offset;
+		if (Property->IsA(UFloatProperty::StaticClass()))
+			Buffer = ParseFloatLiteral(Buffer, *(FLOAT*)pData);
+		else
+		{
+			INT Value;
+			if (Property->IsA(UByteProperty::StaticClass()) && !appIsDigit(*Buffer))
+				return NULL;
+			Buffer = ParseIntLiteral(Buffer, Value);
+			if (!Buffer)
+				return NULL;
+			if (Property->IsA(UByteProperty::StaticClass()))
+				*(BYTE*)pData = (BYTE)Value;
+			else *(INT*)pData = Value;
+		}
+		if (!Buffer)
+			return NULL;
+
+		if (*Buffer == ')')
+			return Buffer + 1;
+		if (*Buffer++ != ',')
+			return NULL;
+	}
+}
+
 const TCHAR* UStructProperty::ImportText(const TCHAR* Buffer, BYTE* Data, INT PortFlags) const
 {
 	guard(UStructProperty::ImportText);
+	const TCHAR* NumericEnd = ImportNumericStruct(Struct, Buffer, Data);
+	if (NumericEnd)
+		return NumericEnd;
 	if (*Buffer++ == '(')
 	{
 		// Parse all properties.
@@ -177,7 +177,11 @@ static UClass* FactoryCreateText
 			// uncomment these two lines to have the input buffer stripped of comments during the preprocessing phase
 	//		FCommentStrippingFilter CommentStripper(sourceFileName);
 	//		FSequencedTextFilter Filter(CommentStripper, Macro, sourceFileName);
-			Filter.Process(Buffer, BufferEnd, ProcessedBuffer);
+			if (!Filter.LoadCachedResult(Buffer, BufferEnd, ProcessedBuffer))
+			{
+				Filter.Process(Buffer, BufferEnd, ProcessedBuffer);
+				Filter.SaveCachedResult(ProcessedBuffer);
+			}
 
 			const TCHAR* Ptr = *ProcessedBuffer; // have to make a copy of the pointer at the beginning of the FString
 			Buffer = Ptr;
@@ -949,6 +953,10 @@ void MakeMain()
 	}
 	unguard;
 
+	// Every enum tag is known from here on; CompileEnum adds the ones compiled later,
+	// packages loaded for a build mark the lookup stale so FindEnumValue rebuilds it.
+	GEditor->BuildEnumLookup();
+
 	guard(DumpHeader);
 	if (GEditor->DumpClass.Len())
 	{
@@ -987,6 +995,11 @@ void MakeMain()
 				PkgObject->PackageFlags |= PKG_ClientOptional;
 			if (GConfig->GetBool(TEXT("Flags"), TEXT("ServerSideOnly"), B, *IniName) && B)
 				PkgObject->PackageFlags |= PKG_ServerSideOnly;
+			GEditor->bReleaseBuild = (GEditor->ReleasePackages.FindItemIndex(Pkg) != INDEX_NONE);
+			if (GConfig->GetBool(TEXT("Flags"), TEXT("Release"), B, *IniName))
+				GEditor->bReleaseBuild = B;
+			if (GEditor->bReleaseBuild)
+				GWarn->Log(TEXT("Using release profile"));
 			TMultiMap<FString, FString>* LP = GConfig->GetSectionPrivate(TEXT("Load"), 0, 1, *IniName);
 			if (LP)
 			{
@@ -1007,6 +1020,7 @@ void MakeMain()
 						{
 							FMacroProcessingFilter DummyMacroFilter(P->GetName(), TEXT("NULL"));
 							BuiltPckList.AddItem(P->GetFName());
+							GEditor->bEnumLookupBuilt = FALSE; // Pick up the enums it brought in.
 						}
 					}
 				}
@@ -1039,6 +1053,7 @@ void MakeMain()
 						for (FObjectIterator It(UObject::StaticClass()); It; ++It)
 							if (It->IsIn(P) && !It->IsA(ULinker::StaticClass()))
 								It->Rename(It->GetName(), PkgObject);
+						GEditor->bEnumLookupBuilt = FALSE; // New enums, and the merged ones changed owner path.
 					}
 				}
 			}
@@ -1096,7 +1111,7 @@ void MakeMain()
 			ULinkerLoad* Conform = NULL;
 			FString SeekFile(GEditor->EditPackagesInPath * Pkg + TEXT(".u"));
 			guard(LoadConform);
-			if (GFileManager->FileSize(*SeekFile) > 0)
+			if (!GReproducibleSave && GFileManager->FileSize(*SeekFile) > 0) // Reproducible saves don't conform.
 			{
 				UObject::BeginLoad();
 				Conform = UObject::GetPackageLinker(UObject::CreatePackage(NULL, *(US + Pkg + TEXT("_OLD"))), *SeekFile, LOAD_NoWarn | LOAD_NoVerify);
@@ -1114,6 +1129,8 @@ void MakeMain()
 				DEBUG_PrintProperties(*CIt);
 			}*/
 			//DEBUG_PrintValues(FindObject<UObject>(NULL, TEXT("Engine.Default__Info.Sprite")));
+			if (GEditor->bReleaseBuild)
+				GEditor->StripPck(PkgObject);
 			if (GEditor->bShouldObfuscate)
 				GEditor->ObfuscatePck(PkgObject);
 			UObject::SavePackage(PkgObject, NULL, RF_Standalone, *(GEditor->EditPackagesOutPath * Pkg + TEXT(".u")), GError, Conform, 1);
@@ -1177,13 +1194,121 @@ inline UBOOL GetEND(const TCHAR** Stream, const TCHAR* Match)
 	*Stream = Original;
 	return FALSE;
 }
-static FString ReadStructValue(const TCHAR* pStr, const TCHAR*& SourceTextBuffer)
+
+/**
+ * Properties and consts of a struct and its superstructs by name, so that defaults import
+ * doesn't walk the field chain for every line.  Like FindField, the most derived field wins.
+ */
+struct FDefaultsFieldIndex
+{
+	TMap<FName, UProperty*> Properties;
+	TMap<FName, UConst*> Consts;
+};
+static TMap<UStruct*, FDefaultsFieldIndex*> DefaultsFieldIndices;
+
+void ResetDefaultsFieldIndex()
+{
+	for (TMap<UStruct*, FDefaultsFieldIndex*>::TIterator It(DefaultsFieldIndices); It; ++It)
+		delete It.Value();
+	DefaultsFieldIndices.Empty();
+}
+
+static FDefaultsFieldIndex& GetDefaultsFieldIndex(UStruct* Struct)
+{
+	FDefaultsFieldIndex* Index = DefaultsFieldIndices.FindRef(Struct);
+	if (!Index)
+	{
+		Index = new FDefaultsFieldIndex;
+		for (TFieldIterator<UField> It(Struct); It; ++It)
+		{
+			const FName FieldName = It->GetFieldName();
+			if (It->IsA(UProperty::StaticClass()))
+			{
+				if (!Index->Properties.Find(FieldName))
+					Index->Properties.Set(FieldName, (UProperty*)*It);
+			}
+			else if (It->IsA(UConst::StaticClass()))
+			{
+				if (!Index->Consts.Find(FieldName))
+					Index->Consts.Set(FieldName, (UConst*)*It);
+			}
+		}
+		DefaultsFieldIndices.Set(Struct, Index);
+	}
+	return *Index;
+}
+
+static UProperty* FindDefaultsProperty(UStruct* Struct, const TCHAR* Name)
+{
+	// a name that was never added can't belong to a field
+	const FName FieldName(Name, FNAME_Find);
+	return FieldName != NAME_None ? GetDefaultsFieldIndex(Struct).Properties.FindRef(FieldName) : NULL;
+}
+
+static UConst* FindDefaultsConst(UStruct* Struct, const TCHAR* Name)
+{
+	const FName FieldName(Name, FNAME_Find);
+	return FieldName != NAME_None ? GetDefaultsFieldIndex(Struct).Consts.FindRef(FieldName) : NULL;
+}
+
+/**
+ * Collects the classes named by BEGIN OBJECT CLASS= lines, whose defaults must be imported before these.
+ */
+void GetDefaultsTemplateClasses(const TCHAR* SourceText, TArray<UClass*>& OutClasses)
+{
+	FString StrLine;
+	while (ParseLine(&SourceText, StrLine))
+	{
+		const TCHAR* Str = *StrLine;
+		if (GetBEGIN(&Str, TEXT("Object")))
+		{
+			UClass* TemplateClass;
+			if (ParseObject<UClass>(Str, TEXT("Class="), TemplateClass, ANY_PACKAGE))
+				OutClasses.AddUniqueItem(TemplateClass);
+		}
+	}
+}
+
+/**
+ * ParseLine(&Stream, Line, TRUE) for defaultproperties text: copies the line in one go and reuses Line's
+ * buffer from the previous line, instead of appending character by character to an emptied string.
+ */
+static UBOOL ParseDefaultsLine(const TCHAR*& Stream, FString& Line)
+{
+	const TCHAR* Start = Stream;
+	while (*Stream && *Stream != '\n' && *Stream != '\r')
+		Stream++;
+	const INT Len = Stream - Start;
+
+	TArray<TCHAR>& Chars = Line.GetCharArray();
+	if (Chars.Num() < Len + 1)
+		Chars.Add(Len + 1 - Chars.Num());
+	else if (Chars.Num() > Len + 1)
+		Chars.Remove(Len + 1, Chars.Num() - Len - 1);
+	appMemcpy(&Chars(0), Start, Len * sizeof(TCHAR));
+	Chars(Len) = 0;
+
+	// Eat up exactly one CR/LF.
+	if (*Stream == 13)
+		Stream++;
+	if (*Stream == 10)
+		Stream++;
+	return *Stream != 0 || Len != 0;
+}
+
+/**
+ * Condenses a {...} value spanning several lines into MultiLineValue.  Any other value is used in place.
+ *
+ * @return	the value text
+ */
+static const TCHAR* ReadStructValue(const TCHAR* pStr, const TCHAR*& SourceTextBuffer, FString& MultiLineValue)
 {
 	if (*pStr == '{')
 	{
 		INT bracketCnt = 0;
 		UBOOL bInString = FALSE;
-		FString Result;
+		FString& Result = MultiLineValue;
+		Result.Empty();
 		FString CurrentLine;
 
 		// increment through each character until we run out of brackets
@@ -1193,7 +1318,7 @@ static FString ReadStructValue(const TCHAR* pStr, const TCHAR*& SourceTextBuffer
 			if (*pStr == '\0' || *pStr == NULL)
 			{
 				// parse a new line
-				if (ParseLine(&SourceTextBuffer, CurrentLine, TRUE))
+				if (ParseDefaultsLine(SourceTextBuffer, CurrentLine))
 				{
 					if (ContextSupplier != NULL)
 					{
@@ -1250,7 +1375,7 @@ static FString ReadStructValue(const TCHAR* pStr, const TCHAR*& SourceTextBuffer
 		} while (bracketCnt != 0);
 
 
-		return Result;
+		return *Result;
 	}
 
 	return pStr;
@@ -1293,10 +1418,10 @@ static const INT ReadArrayIndex(UStruct* ObjectStruct, UClass* TopOuter, const T
 						if (eValue == 255)
 						{
 							// search for const ref
-							UConst* Const = FindField<UConst>(ObjectStruct, *IndexText);
+							UConst* Const = FindDefaultsConst(ObjectStruct, *IndexText);
 							if (Const == NULL && TopOuter != NULL)
 							{
-								Const = FindField<UConst>(TopOuter, *IndexText);
+								Const = FindDefaultsConst(TopOuter, *IndexText);
 							}
 
 							if (Const != NULL)
@@ -1459,21 +1584,15 @@ static const TCHAR* ImportProperties(
 	FString StrLine;
 
 	// If bootstrapping, check the class we're BEGIN OBJECTing has had its properties imported.
-	if (Depth == 0)
+	// Not needed when class defaults are imported in dependency order, that already took care of it.
+	if (Depth == 0 && !GEditor->bDefaultsScheduled)
 	{
-		const TCHAR* TempData = SourceText;
-		while (ParseLine(&TempData, StrLine))
+		TArray<UClass*> TemplateClasses;
+		GetDefaultsTemplateClasses(SourceText, TemplateClasses);
+		for (INT i = 0; i < TemplateClasses.Num(); i++)
 		{
-			const TCHAR* Str = *StrLine;
-			if (GetBEGIN(&Str, TEXT("Object")))
-			{
-				UClass* TemplateClass;
-				if (ParseObject<UClass>(Str, TEXT("Class="), TemplateClass, ANY_PACKAGE))
-				{
-					if (!UEditor::ImportDefaultProps(TemplateClass))
-						return NULL;
-				}
-			}
+			if (!UEditor::ImportDefaultProps(TemplateClasses(i)))
+				return NULL;
 		}
 	}
 
@@ -1485,7 +1604,8 @@ static const TCHAR* ImportProperties(
 	// Parse all objects stored in the actor.
 	// Build list of all text properties.
 	UBOOL ImportedBrush = 0;
-	while (ParseLine(&SourceText, StrLine, TRUE))
+	FString MultiLineValue;
+	while (ParseDefaultsLine(SourceText, StrLine))
 	{
 		const TCHAR* Str = *StrLine;
 
@@ -1545,10 +1665,14 @@ static const TCHAR* ImportProperties(
 				UObject* ParentCDO = ParentClass->GetDefaultObject();
 				check(ParentCDO);
 
-				FObjectRefFinder Finder(NULL, TemplateName);
-				Finder.SeekForObject(ParentCDO);
-
-				BaseTemplate = Finder.ResultObject;
+				// component templates are indexed by the parent class; anything else has to be searched for
+				BaseTemplate = ParentClass->ComponentNameToDefaultObjectMap.FindRef(TemplateName);
+				if (BaseTemplate == NULL)
+				{
+					FObjectRefFinder Finder(NULL, TemplateName);
+					Finder.SeekForObject(ParentCDO);
+					BaseTemplate = Finder.ResultObject;
+				}
 				if (BaseTemplate == NULL)
 				{
 					// wasn't found
@@ -1821,7 +1945,7 @@ static const TCHAR* ImportProperties(
 					}
 				}
 
-				UProperty* Property = FindField<UProperty>(ObjectStruct, Token);
+				UProperty* Property = FindDefaultsProperty(ObjectStruct, Token);
 
 				// this the default parent to use
 				UProperty::ImportTextParent = (GEditor->Bootstrapping && SubobjectOuter != NULL) ? SubobjectOuter : *(UObject**)DestData;
@@ -1830,7 +1954,7 @@ static const TCHAR* ImportProperties(
 				{
 					// Check for a delegate property
 					FString DelegateName = FString::Printf(TEXT("__%s__Delegate"), Token);
-					Property = FindField<UDelegateProperty>(ObjectStruct, *DelegateName);
+					Property = Cast<UDelegateProperty>(FindDefaultsProperty(ObjectStruct, *DelegateName));
 					if (!Property)
 					{
 						Warn->Logf(NAME_Warning, TEXT("Unknown property in defaults: %s (looked in %s)"), *StrLine, *ObjectStruct->GetName());
@@ -1874,8 +1998,7 @@ static const TCHAR* ImportProperties(
 						}
 						SkipWhitespace(Str);
 
-						FString ValueText = ReadStructValue(Str, SourceText);
-						Str = *ValueText;
+						Str = ReadStructValue(Str, SourceText, MultiLineValue);
 
 						if (ArrayOp == ADO_Add)
 						{
@@ -2030,17 +2153,18 @@ static const TCHAR* ImportProperties(
 					SkipWhitespace(Str);
 
 					// limited multi-line support, look for {...} sequences and condense to a single entry
-					FString FullText = ReadStructValue(Str, SourceText);
-
-					// set the pointer to our new text
-					Str = *FullText;
+					Str = ReadStructValue(Str, SourceText, MultiLineValue);
 					if (Property->GetFName() != NAME_Name)
 					{
 						l = appStrlen(Str);
+						const INT ValueLen = l;
 						while (l && (Str[l - 1] == ';' || Str[l - 1] == ' ' || Str[l - 1] == 9))
-						{
-							*(TCHAR*)(&Str[l - 1]) = 0;
 							--l;
+						if (l != ValueLen)
+						{
+							// Single-line values point into StrLine, which must stay intact for the warnings below.
+							MultiLineValue = FString(l, Str);
+							Str = *MultiLineValue;
 						}
 						if (Property->IsA(UStrProperty::StaticClass()) && (!l || *Str != '"' || Str[l - 1] != '"'))
 							Warn->Logf(NAME_Warning, TEXT("Missing '\"' in string default properties: %s"), *StrLine);
@@ -2106,11 +2230,11 @@ static const TCHAR* ImportProperties(
 								// it could be a named constant, so let's try checking for that first
 
 								// If this is a subobject definition, search for a matching const in the containing (top-level) class first
-								UConst* Const = FindField<UConst>(bSubObject ? ComponentOwnerClass : ObjectStruct, Str);
+								UConst* Const = FindDefaultsConst(bSubObject ? ComponentOwnerClass : ObjectStruct, Str);
 								if (Const == NULL && bSubObject)
 								{
 									// if it still wasn't found, try searching the subobject's class
-									Const = FindField<UConst>(ObjectStruct, Str);
+									Const = FindDefaultsConst(ObjectStruct, Str);
 								}
 								if (Const == NULL)
 									Const = FindObject<UConst>(ANY_PACKAGE, Str, 1);
@@ -2172,11 +2296,11 @@ static const TCHAR* ImportProperties(
 								// The property failed to import the value - this means the text was't valid for this property type
 								// it could be a named constant, so let's try checking for that first
 								// If this is a subobject definition, search for a matching const in the containing (top-level) class first
-								UConst* Const = FindField<UConst>(bSubObject ? SubobjectRoot->GetClass() : ObjectStruct, Str);
+								UConst* Const = FindDefaultsConst(bSubObject ? SubobjectRoot->GetClass() : ObjectStruct, Str);
 								if (Const == NULL && bSubObject)
 								{
 									// if it still wasn't found, try searching the subobject's class
-									Const = FindField<UConst>(ObjectStruct, Str);
+									Const = FindDefaultsConst(ObjectStruct, Str);
 								}
 								if (Const == NULL)
 									Const = FindObject<UConst>(ANY_PACKAGE, Str, 1);
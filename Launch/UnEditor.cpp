@@ -8,17 +8,28 @@ void UEditor::InitEditor()
 	GEditor = new UEditor();
 }
 UEditor::UEditor()
-	: Bootstrapping(1), ParentContext(NULL), iFunctionOffset(41), bShouldObfuscate(FALSE)
+	: Bootstrapping(1), ParentContext(NULL), iFunctionOffset(41), bShouldObfuscate(FALSE), bOptimizeBytecode(FALSE), bPerfLint(FALSE), bReleaseBuild(FALSE), bDefaultsScheduled(FALSE), bEnumLookupBuilt(FALSE)
 {
 	GConfig->GetString(TEXT("Make"), TEXT("OutPath"), EditPackagesOutPath);
 	GConfig->GetString(TEXT("Make"), TEXT("InPath"), EditPackagesInPath);
 	GConfig->GetString(TEXT("Make"), TEXT("DumpClass"), DumpClass);
 	GConfig->GetArray(TEXT("Make"), TEXT("LoadPackages"), &LoadPackages);
 	GConfig->GetArray(TEXT("Make"), TEXT("EditPackages"), &EditPackages);
+	GConfig->GetArray(TEXT("Make"), TEXT("DevirtualizePackages"), &DevirtualizePackages);
+	GConfig->GetArray(TEXT("Make"), TEXT("ReleasePackages"), &ReleasePackages);
 	GConfig->GetArray(TEXT("Make"), TEXT("Paths"), &GSys->Paths);
 	GConfig->GetArray(TEXT("Make"), TEXT("Extensions"), &GSys->Extensions);
 	GConfig->GetInt(TEXT("Make"), TEXT("CodeMemoryOffset"), iFunctionOffset);
 	GConfig->GetBool(TEXT("Make"), TEXT("Obfuscate"), bShouldObfuscate);
+	GConfig->GetBool(TEXT("Make"), TEXT("OptimizeBytecode"), bOptimizeBytecode);
+	GConfig->GetBool(TEXT("Make"), TEXT("PerfLint"), bPerfLint);
+	GConfig->GetString(TEXT("Make"), TEXT("PerfLintPath"), PerfLintPath);
+	GConfig->GetBool(TEXT("Make"), TEXT("Reproducible"), GReproducibleSave);
+	GConfig->GetString(TEXT("Make"), TEXT("PreprocessCachePath"), PreprocessCachePath);
+
+	FString LinkerCachePath;
+	if (GConfig->GetString(TEXT("Make"), TEXT("LinkerCachePath"), LinkerCachePath))
+		appStrncpy(GLinkerCachePath, *LinkerCachePath, ARRAY_COUNT(GLinkerCachePath));
 }
 UBOOL UEditor::SafeExec(const TCHAR* Cmd, FOutputDevice& Out)
 {
@@ -241,28 +252,82 @@ void UEditor::ObfuscatePck(UPackage* P)
 	unguard;
 }
 
-BYTE UEditor::FindEnumValue(FName ValueName)
+// Drop the compile-only info a release package doesn't need at runtime.
+void UEditor::StripPck(UPackage* P)
 {
-	guard(UEditor::FindEnumValue);
-	BYTE Result = 255;
-	BYTE* iFound = EnumLookup.Find(ValueName);
-
-	if (iFound)
-		return *iFound;
+	guard(UEditor::StripPck);
+	for (TObjectIterator<UStruct> It; It; ++It)
+	{
+		if (!It->IsIn(P))
+			continue;
+		It->Line = 0;
+		It->TextPos = 0;
+	}
+	for (TObjectIterator<UProperty> It; It; ++It)
+	{
+		// Transient/native properties without a category aren't exported, so leave those alone.
+		if (It->IsIn(P) && !(It->PropertyFlags & (CPF_Transient | CPF_Native)))
+			It->Category = NAME_None;
+	}
+	unguard;
+}
 
-	// Try to find an enum with matching name.
+void UEditor::BuildEnumLookup()
+{
+	guard(UEditor::BuildEnumLookup);
+	EnumLookup.Empty();
+	EnumLookupOwner.Empty();
+	AmbiguousEnumValues.Empty();
 	for (TObjectIterator<UEnum> It; It; ++It)
+		AddEnumValues(*It);
+	bEnumLookupBuilt = TRUE;
+	unguard;
+}
+
+void UEditor::AddEnumValues(UEnum* Enum)
+{
+	guard(UEditor::AddEnumValues);
+	if (!bEnumLookupBuilt)
+		return; // Picked up by the next BuildEnumLookup.
+	const FString EnumPath = Enum->GetPathName();
+	for (INT i = 0; i < Enum->Names.Num(); i++)
 	{
-		INT ix = It->Names.FindItemIndex(ValueName);
-		if (ix != INDEX_NONE)
+		const FName ValueName = Enum->Names(i);
+		const BYTE* Existing = EnumLookup.Find(ValueName);
+		const FString* Owner = EnumLookupOwner.Find(ValueName);
+		if (!Existing || *Owner == EnumPath)
 		{
-			Result = ix;
-			break;
+			// New tag, or an enum that is being compiled again.
+			EnumLookup.Set(ValueName, i);
+			EnumLookupOwner.Set(ValueName, EnumPath);
+		}
+		else if (*Existing != i)
+		{
+			// The same tag under the same value is harmless, only report tags that could mean two things.
+			FString* Owners = AmbiguousEnumValues.Find(ValueName);
+			if (!Owners)
+				Owners = &AmbiguousEnumValues.Set(ValueName, FString::Printf(TEXT("%ls=%i"), **Owner, *Existing));
+			*Owners += FString::Printf(TEXT(", %ls=%i"), *EnumPath, i);
 		}
 	}
-	EnumLookup.Set(ValueName, Result);
+	unguard;
+}
 
-	return Result;
+BYTE UEditor::FindEnumValue(FName ValueName)
+{
+	guard(UEditor::FindEnumValue);
+	if (!bEnumLookupBuilt)
+		BuildEnumLookup();
+
+	const FString* Owners = AmbiguousEnumValues.Find(ValueName);
+	if (Owners)
+	{
+		GWarn->Logf(NAME_Warning, TEXT("Enum tag '%ls' is ambiguous (%ls), use a typed context or a const instead"), *ValueName, **Owners);
+		return 255;
+	}
+
+	const BYTE* Found = EnumLookup.Find(ValueName);
+	return Found ? *Found : 255;
 	unguard;
 }
 BYTE UEditor::FindEnumValue(const TCHAR* ValueName)
@@ -22,17 +22,28 @@ const TCHAR* ImportDefaultProperties(
 	INT					Depth,
 	INT					LineNumber = INDEX_NONE
 );
+void ResetDefaultsFieldIndex();
+void GetDefaultsTemplateClasses(const TCHAR* SourceText, TArray<UClass*>& OutClasses);
 
 class UEditor
 {
 public:
 	FString EditPackagesOutPath,EditPackagesInPath,DumpClass;
-	TArray<FString> EditPackages,LoadPackages;
+	TArray<FString> EditPackages,LoadPackages,DevirtualizePackages,ReleasePackages;
 	INT Bootstrapping;
 	UObject* ParentContext;
 	INT iFunctionOffset;
 	UBOOL bShouldObfuscate;
-	TMap<FName, BYTE> EnumLookup;
+	UBOOL bOptimizeBytecode;
+	UBOOL bPerfLint;
+	FString PerfLintPath;
+	FString PreprocessCachePath;
+	UBOOL bReleaseBuild; // Package currently being compiled uses the release profile.
+	UBOOL bDefaultsScheduled; // Class defaults are being imported in dependency order.
+	TMap<FName, BYTE> EnumLookup; // Value of every enum tag, see BuildEnumLookup.
+	TMap<FName, FString> EnumLookupOwner; // Path of the enum that defined the EnumLookup entry.
+	TMap<FName, FString> AmbiguousEnumValues; // Tags defined with different values by several enums, and by which.
+	UBOOL bEnumLookupBuilt;
 
 	UEditor();
 
@@ -43,11 +54,14 @@ public:
 
 	void ExportHeader(UStruct* S);
 	void ObfuscatePck(UPackage* P);
+	void StripPck(UPackage* P);
 
 	UBOOL SafeExec(const TCHAR* Cmd, FOutputDevice& Out);
 
 	UBOOL MakeScripts(FFeedbackContext* Warn, UPackage* MyPackage, TArray<UClass*>& AllClasses);
 
+	void BuildEnumLookup();
+	void AddEnumValues(UEnum* Enum);
 	BYTE FindEnumValue(FName ValueName);
 	BYTE FindEnumValue(const TCHAR* ValueName);
 
@@ -324,89 +324,6 @@ void FToken::Clone( const FToken& Other )
 	String = Other.String;
 }
 
-/**
- * Static helper function to determine whether the class hierarchy rooted at Suspect is
- * dependent on the hierarchy rooted at Source.
- *
- * @param	Suspect		Root of hierarchy for suspect class
- * @param	Source		Root of hierarchy for source class
- * @param	AllClasses	Array of parsed classes
- * @return	TRUE if the hierarchy rooted at Suspect is dependent on the one rooted at Source, FALSE otherwise
- */
-UBOOL FScriptCompiler::IsDependentOn( UClass* Suspect, UClass* Source, const TArray<UClass*>& AllClasses )
-{
-	check( Source );
-	check( Suspect );
-
-    // A class is not dependent on itself.
-    if( Suspect == Source )
-    {
-        return FALSE;
-    }
-
-    // Children are all implicitly dependent on their parent, that is, children require their parent
-	// to be compiled first therefore if the source is a parent of the suspect, the suspect is
-	// dependent on the source.
-    if( Suspect->IsChildOf( Source ) )
-    {
-        return TRUE;
-    }
-
-    // Now consider all dependents of the suspect. If any of them are dependent on the source, the
-	// suspect is too.
-    for( INT NameIndex=0; NameIndex<Suspect->DependentOn.Num(); NameIndex++ )
-	{
-		FName	DependencyName	= Suspect->DependentOn(NameIndex);
-		UClass*	Dependency		= FindClass(*DependencyName);/*FindObject<UClass>( ANY_PACKAGE, *DependencyName.ToString() );*/
-
-		if( !Dependency )
-		{
-			// Error.
-			continue;
-		}
-
-		// the parser disallows declaring the parent class as a dependency, so the only way this could occur is
-		// if the parent for a native class has been changed (which causes the new parent to be inserted as a dependency),
-		// if this is the case, skip it or we'll go into a loop
-		if ( Suspect->GetSuperClass() == Dependency )
-		{
-			continue;
-		}
-
-		if( Dependency == Source || IsDependentOn( Dependency, Source, AllClasses ) )
-		{
-			return TRUE;
-		}
-	}
-
-	// Consider all children of the suspect if any of them are dependent on the source, the suspect is
-	// too because it itself is dependent on its children.
-
-	if(!Suspect->HasAnyClassFlags(CLASS_Interface))
-	{
-		if (AllClasses.FindItemIndex(Suspect) == INDEX_NONE)
-		{
-			ScriptErrorf(SCEL_Parse, TEXT("Unparsed class '%s' found while validating DependsOn entries for '%s'"), Suspect->GetName(), Source->GetName());
-			return FALSE;
-		}
-	}
-
-// 	TArray<const FClassTree*> SuspectChildren;
-// 	SuspectLeaf->GetChildClasses(SuspectChildren);
-// 
-// 	for( INT ClassIndex=0; ClassIndex<SuspectChildren.Num(); ClassIndex++ )
-// 	{
-// 		const FClassTree* ChildLeaf = SuspectChildren(ClassIndex);
-// 		UClass* Class = ChildLeaf->GetClass();
-// 		if( IsDependentOn( Class, Source, AllClasses ) )
-// 		{
-// 			return TRUE;
-// 		}
-// 	}
-
-    return FALSE;
-}
-
 FFunctionData* FClassMetaData::FindFunctionData( UFunction* Function )
 {
 	guard(FClassMetaData::FindFunctionData);
@@ -750,6 +667,67 @@ const TCHAR* FScriptCompiler::GetRestOfLine() const
 	return Result;
 }
 
+//
+// Look up a token previously lexed starting at LexPos of the current input.
+// On success, fills in Token and leaves the input exactly where lexing it did.
+//
+UBOOL FScriptCompiler::GetLexedToken( FToken& Token, INT LexPos, UBOOL NoConsts )
+{
+	if( !CurrentLexedTokens || CurrentLexedTokens->Input!=Input || CurrentLexedTokens->InputLen!=InputLen )
+	{
+		return FALSE;
+	}
+	const FLexedToken* Lexed = CurrentLexedTokens->Tokens.Find( (LexPos<<1) | (NoConsts ? 1 : 0) );
+	if( !Lexed )
+	{
+		return FALSE;
+	}
+	Token.TokenType	= Lexed->TokenType;
+	Token.Identifier	= Lexed->Identifier;
+	Token.StartPos		= Lexed->StartPos;
+	Token.StartLine		= Lexed->StartLine;
+
+	// Names can be added after the token was first lexed (e.g. by a declaration later in the class).
+	Token.TokenName	= Lexed->TokenName!=NAME_None ? Lexed->TokenName : FName(*Lexed->Identifier, FNAME_Find);
+
+	InputPos	= Lexed->EndPos;
+	InputLine	= Lexed->EndLine;
+	PrevPos		= Lexed->PrevPos;
+	PrevLine	= Lexed->PrevLine;
+	return TRUE;
+}
+
+//
+// Remember a freshly lexed identifier or symbol.  Tokens whose lexing touched
+// a comment are skipped, since replaying them would not update PrevComment.
+//
+void FScriptCompiler::StoreLexedToken( const FToken& Token, INT LexPos, UBOOL NoConsts )
+{
+	if( !CurrentLexedTokens || CurrentLexedTokens->Input!=Input || CurrentLexedTokens->InputLen!=InputLen || Token.Identifier.Len()!=InputPos-Token.StartPos )
+	{
+		return;
+	}
+	const INT LastPos = Min( InputPos, InputLen-1 );
+	for( INT i=LexPos; i<=LastPos; i++ )
+	{
+		if( Input[i]=='/' || Input[i]=='*' )
+		{
+			return;
+		}
+	}
+	FLexedToken Lexed;
+	Lexed.TokenType	= Token.TokenType;
+	Lexed.TokenName	= Token.TokenName;
+	Lexed.Identifier	= Token.Identifier;
+	Lexed.StartPos		= Token.StartPos;
+	Lexed.StartLine		= Token.StartLine;
+	Lexed.EndPos		= InputPos;
+	Lexed.EndLine		= InputLine;
+	Lexed.PrevPos		= PrevPos;
+	Lexed.PrevLine		= PrevLine;
+	CurrentLexedTokens->Tokens.Set( (LexPos<<1) | (NoConsts ? 1 : 0), Lexed );
+}
+
 //
 // Unget the previous character retrieved with GetChar().
 //
@@ -1036,6 +1014,268 @@ void FScriptCompiler::EmitConstant( FToken& Token )
 	}
 }
 
+/*-----------------------------------------------------------------------------
+	Constant folding.
+-----------------------------------------------------------------------------*/
+
+// Object operators that can be evaluated at compile time.
+enum EFoldedOperator
+{
+	FOLD_Add_IntInt,
+	FOLD_Subtract_IntInt,
+	FOLD_Multiply_IntInt,
+	FOLD_Divide_IntInt,
+	FOLD_LessLess_IntInt,
+	FOLD_GreaterGreater_IntInt,
+	FOLD_GreaterGreaterGreater_IntInt,
+	FOLD_And_IntInt,
+	FOLD_Or_IntInt,
+	FOLD_Xor_IntInt,
+	FOLD_Less_IntInt,
+	FOLD_Greater_IntInt,
+	FOLD_LessEqual_IntInt,
+	FOLD_GreaterEqual_IntInt,
+	FOLD_EqualEqual_IntInt,
+	FOLD_NotEqual_IntInt,
+	FOLD_Subtract_PreInt,
+	FOLD_Complement_PreInt,
+	FOLD_Add_FloatFloat,
+	FOLD_Subtract_FloatFloat,
+	FOLD_Multiply_FloatFloat,
+	FOLD_Divide_FloatFloat,
+	FOLD_Less_FloatFloat,
+	FOLD_Greater_FloatFloat,
+	FOLD_LessEqual_FloatFloat,
+	FOLD_GreaterEqual_FloatFloat,
+	FOLD_EqualEqual_FloatFloat,
+	FOLD_NotEqual_FloatFloat,
+	FOLD_Subtract_PreFloat,
+	FOLD_Not_PreBool,
+	FOLD_AndAnd_BoolBool,
+	FOLD_OrOr_BoolBool,
+	FOLD_XorXor_BoolBool,
+	FOLD_EqualEqual_BoolBool,
+	FOLD_NotEqual_BoolBool,
+	FOLD_Concat_StrStr,
+	FOLD_At_StrStr,
+	FOLD_Less_StrStr,
+	FOLD_Greater_StrStr,
+	FOLD_LessEqual_StrStr,
+	FOLD_GreaterEqual_StrStr,
+	FOLD_EqualEqual_StrStr,
+	FOLD_NotEqual_StrStr,
+	FOLD_EqualEqual_NameName,
+	FOLD_NotEqual_NameName,
+	FOLD_Add_VectorVector,
+	FOLD_Subtract_VectorVector,
+	FOLD_Multiply_VectorFloat,
+	FOLD_Multiply_FloatVector,
+	FOLD_Multiply_VectorVector,
+	FOLD_Divide_VectorFloat,
+	FOLD_Subtract_PreVector,
+	FOLD_Add_RotatorRotator,
+	FOLD_Subtract_RotatorRotator,
+	FOLD_MAX
+};
+
+static INT FindFoldedOperator( UFunction* Function )
+{
+	static const TCHAR* FoldedOperatorNames[FOLD_MAX] =
+	{
+		TEXT("Add_IntInt"), TEXT("Subtract_IntInt"), TEXT("Multiply_IntInt"), TEXT("Divide_IntInt"),
+		TEXT("LessLess_IntInt"), TEXT("GreaterGreater_IntInt"), TEXT("GreaterGreaterGreater_IntInt"),
+		TEXT("And_IntInt"), TEXT("Or_IntInt"), TEXT("Xor_IntInt"),
+		TEXT("Less_IntInt"), TEXT("Greater_IntInt"), TEXT("LessEqual_IntInt"), TEXT("GreaterEqual_IntInt"), TEXT("EqualEqual_IntInt"), TEXT("NotEqual_IntInt"),
+		TEXT("Subtract_PreInt"), TEXT("Complement_PreInt"),
+		TEXT("Add_FloatFloat"), TEXT("Subtract_FloatFloat"), TEXT("Multiply_FloatFloat"), TEXT("Divide_FloatFloat"),
+		TEXT("Less_FloatFloat"), TEXT("Greater_FloatFloat"), TEXT("LessEqual_FloatFloat"), TEXT("GreaterEqual_FloatFloat"), TEXT("EqualEqual_FloatFloat"), TEXT("NotEqual_FloatFloat"),
+		TEXT("Subtract_PreFloat"),
+		TEXT("Not_PreBool"), TEXT("AndAnd_BoolBool"), TEXT("OrOr_BoolBool"), TEXT("XorXor_BoolBool"), TEXT("EqualEqual_BoolBool"), TEXT("NotEqual_BoolBool"),
+		TEXT("Concat_StrStr"), TEXT("At_StrStr"),
+		TEXT("Less_StrStr"), TEXT("Greater_StrStr"), TEXT("LessEqual_StrStr"), TEXT("GreaterEqual_StrStr"), TEXT("EqualEqual_StrStr"), TEXT("NotEqual_StrStr"),
+		TEXT("EqualEqual_NameName"), TEXT("NotEqual_NameName"),
+		TEXT("Add_VectorVector"), TEXT("Subtract_VectorVector"), TEXT("Multiply_VectorFloat"), TEXT("Multiply_FloatVector"), TEXT("Multiply_VectorVector"), TEXT("Divide_VectorFloat"),
+		TEXT("Subtract_PreVector"),
+		TEXT("Add_RotatorRotator"), TEXT("Subtract_RotatorRotator"),
+	};
+	static TMap<FName,INT> FoldedOperators;
+	if( !FoldedOperators.Num() )
+	{
+		for( INT i=0; i<FOLD_MAX; i++ )
+		{
+			FoldedOperators.Set( FName(FoldedOperatorNames[i]), i );
+		}
+	}
+
+	// Only Object's own native operators; anything else may behave differently.
+	if( !(Function->FunctionFlags & FUNC_Native) || Function->GetOuter()!=UObject::StaticClass() )
+	{
+		return INDEX_NONE;
+	}
+	const INT* Found = FoldedOperators.Find( Function->GetFName() );
+	return Found ? *Found : INDEX_NONE;
+}
+
+/**
+ * Replace a native Object operator whose operands are all constants with the constant it evaluates to.
+ * The operands must already have exactly the operator's parameter types and be all the code emitted
+ * since StartOfExpression, and the result is computed the same way the native implementation does.
+ *
+ * @param	Operator			the operator overload that was picked
+ * @param	IsPreOperator		TRUE for unary operators, which only take Right
+ * @param	Left				left operand, unused for unary operators
+ * @param	Right				right operand
+ * @param	StartOfExpression	code location of the left operand
+ * @param	MidRetry			code location of the right operand
+ * @param	Result				[out] the folded constant
+ *
+ * @return	TRUE if the operator was folded and Result emitted in place of the operands
+ */
+UBOOL FScriptCompiler::FoldConstantOperator( UFunction* Operator, UBOOL IsPreOperator, FToken& Left, FToken& Right, FScriptLocation& StartOfExpression, FScriptLocation& MidRetry, FToken& Result )
+{
+	const INT Fold = FindFoldedOperator( Operator );
+	if( Fold==INDEX_NONE || Right.TokenType!=TOKEN_Const || (!IsPreOperator && Left.TokenType!=TOKEN_Const) )
+	{
+		return FALSE;
+	}
+
+	// The operands must need no conversion.
+	TFieldIterator<UProperty> It(Operator);
+	if( !IsPreOperator )
+	{
+		const FPropertyBase LeftParm(*It);
+		if( LeftParm.Type!=Left.Type || LeftParm.IsVector()!=Left.IsVector() || LeftParm.IsRotator()!=Left.IsRotator() )
+		{
+			return FALSE;
+		}
+		++It;
+	}
+	const FPropertyBase RightParm(*It);
+	if( RightParm.Type!=Right.Type || RightParm.IsVector()!=Right.IsVector() || RightParm.IsRotator()!=Right.IsRotator() )
+	{
+		return FALSE;
+	}
+
+	// Make sure the code really is just the operand constants, by emitting them again and comparing.
+	TArray<BYTE>& Script = TopNode->Script;
+	const INT CodeStart = IsPreOperator ? MidRetry.CodeTop : StartOfExpression.CodeTop;
+	const INT CodeMid = MidRetry.CodeTop;
+	const INT CodeEnd = Script.Num();
+	if( !IsPreOperator )
+	{
+		EmitConstant( Left );
+	}
+	const INT CheckMid = Script.Num();
+	EmitConstant( Right );
+	const UBOOL bPureConstants =
+		CodeStart==StartOfExpression.CodeTop
+	&&	CheckMid-CodeEnd==CodeMid-CodeStart
+	&&	Script.Num()-CheckMid==CodeEnd-CodeMid
+	&&	appMemcmp( &Script(0)+CodeStart, &Script(0)+CodeEnd, Script.Num()-CodeEnd )==0;
+	Script.Remove( CodeEnd, Script.Num()-CodeEnd );
+	if( !bPureConstants )
+	{
+		return FALSE;
+	}
+
+	// Evaluate.  Integer math wraps like the native code does, and float results are rounded to single precision.
+	const INT		A = Left.Int,	B = Right.Int;
+	const FLOAT		FA = Left.Float, FB = Right.Float;
+	volatile FLOAT	F;
+	FVector			V;
+	FRotator		R;
+	switch( Fold )
+	{
+		case FOLD_Add_IntInt:				Result.SetConstInt( (INT)((DWORD)A + (DWORD)B) ); break;
+		case FOLD_Subtract_IntInt:			Result.SetConstInt( (INT)((DWORD)A - (DWORD)B) ); break;
+		case FOLD_Multiply_IntInt:			Result.SetConstInt( (INT)((DWORD)A * (DWORD)B) ); break;
+		case FOLD_Divide_IntInt:
+			if( B==0 || ((DWORD)A==0x80000000 && B==-1) )
+			{
+				return FALSE;
+			}
+			Result.SetConstInt( A / B );
+			break;
+		case FOLD_LessLess_IntInt:
+		case FOLD_GreaterGreater_IntInt:
+		case FOLD_GreaterGreaterGreater_IntInt:
+			if( B<0 || B>31 )
+			{
+				return FALSE;
+			}
+			Result.SetConstInt( Fold==FOLD_LessLess_IntInt ? (INT)((DWORD)A << B) : Fold==FOLD_GreaterGreater_IntInt ? (A >> B) : (INT)((DWORD)A >> B) );
+			break;
+		case FOLD_And_IntInt:				Result.SetConstInt( A & B ); break;
+		case FOLD_Or_IntInt:				Result.SetConstInt( A | B ); break;
+		case FOLD_Xor_IntInt:				Result.SetConstInt( A ^ B ); break;
+		case FOLD_Less_IntInt:				Result.SetConstBool( A < B ); break;
+		case FOLD_Greater_IntInt:			Result.SetConstBool( A > B ); break;
+		case FOLD_LessEqual_IntInt:			Result.SetConstBool( A <= B ); break;
+		case FOLD_GreaterEqual_IntInt:		Result.SetConstBool( A >= B ); break;
+		case FOLD_EqualEqual_IntInt:		Result.SetConstBool( A == B ); break;
+		case FOLD_NotEqual_IntInt:			Result.SetConstBool( A != B ); break;
+		case FOLD_Subtract_PreInt:			Result.SetConstInt( (INT)(0 - (DWORD)B) ); break;
+		case FOLD_Complement_PreInt:		Result.SetConstInt( ~B ); break;
+		case FOLD_Add_FloatFloat:			F = FA + FB; Result.SetConstFloat( F ); break;
+		case FOLD_Subtract_FloatFloat:		F = FA - FB; Result.SetConstFloat( F ); break;
+		case FOLD_Multiply_FloatFloat:		F = FA * FB; Result.SetConstFloat( F ); break;
+		case FOLD_Divide_FloatFloat:
+			if( FB==0.f )
+			{
+				return FALSE;
+			}
+			F = FA / FB;
+			Result.SetConstFloat( F );
+			break;
+		case FOLD_Less_FloatFloat:			Result.SetConstBool( FA < FB ); break;
+		case FOLD_Greater_FloatFloat:		Result.SetConstBool( FA > FB ); break;
+		case FOLD_LessEqual_FloatFloat:		Result.SetConstBool( FA <= FB ); break;
+		case FOLD_GreaterEqual_FloatFloat:	Result.SetConstBool( FA >= FB ); break;
+		case FOLD_EqualEqual_FloatFloat:	Result.SetConstBool( FA == FB ); break;
+		case FOLD_NotEqual_FloatFloat:		Result.SetConstBool( FA != FB ); break;
+		case FOLD_Subtract_PreFloat:		Result.SetConstFloat( -FB ); break;
+		case FOLD_Not_PreBool:				Result.SetConstBool( !Right.Bool ); break;
+		case FOLD_AndAnd_BoolBool:			Result.SetConstBool( Left.Bool && Right.Bool ); break;
+		case FOLD_OrOr_BoolBool:			Result.SetConstBool( Left.Bool || Right.Bool ); break;
+		case FOLD_XorXor_BoolBool:			Result.SetConstBool( !Left.Bool ^ !Right.Bool ); break;
+		case FOLD_EqualEqual_BoolBool:		Result.SetConstBool( !Left.Bool == !Right.Bool ); break;
+		case FOLD_NotEqual_BoolBool:		Result.SetConstBool( !Left.Bool != !Right.Bool ); break;
+		case FOLD_Concat_StrStr:			Result.SetConstString( *(Left.String + Right.String) ); break;
+		case FOLD_At_StrStr:				Result.SetConstString( *(Left.String + TEXT(" ") + Right.String) ); break;
+		case FOLD_Less_StrStr:				Result.SetConstBool( appStrcmp(*Left.String,*Right.String) < 0 ); break;
+		case FOLD_Greater_StrStr:			Result.SetConstBool( appStrcmp(*Left.String,*Right.String) > 0 ); break;
+		case FOLD_LessEqual_StrStr:			Result.SetConstBool( appStrcmp(*Left.String,*Right.String) <= 0 ); break;
+		case FOLD_GreaterEqual_StrStr:		Result.SetConstBool( appStrcmp(*Left.String,*Right.String) >= 0 ); break;
+		case FOLD_EqualEqual_StrStr:		Result.SetConstBool( appStrcmp(*Left.String,*Right.String) == 0 ); break;
+		case FOLD_NotEqual_StrStr:			Result.SetConstBool( appStrcmp(*Left.String,*Right.String) != 0 ); break;
+		case FOLD_EqualEqual_NameName:		Result.SetConstBool( Left.NameBytes == Right.NameBytes ); break;
+		case FOLD_NotEqual_NameName:		Result.SetConstBool( Left.NameBytes != Right.NameBytes ); break;
+		case FOLD_Add_VectorVector:			V = Left.VectorBytes + Right.VectorBytes; Result.SetConstVector( V ); break;
+		case FOLD_Subtract_VectorVector:	V = Left.VectorBytes - Right.VectorBytes; Result.SetConstVector( V ); break;
+		case FOLD_Multiply_VectorFloat:		V = Left.VectorBytes * FB; Result.SetConstVector( V ); break;
+		case FOLD_Multiply_FloatVector:		V = FA * Right.VectorBytes; Result.SetConstVector( V ); break;
+		case FOLD_Multiply_VectorVector:	V = Left.VectorBytes * Right.VectorBytes; Result.SetConstVector( V ); break;
+		case FOLD_Divide_VectorFloat:
+			if( FB==0.f )
+			{
+				return FALSE;
+			}
+			V = Left.VectorBytes / FB;
+			Result.SetConstVector( V );
+			break;
+		case FOLD_Subtract_PreVector:		V = -Right.VectorBytes; Result.SetConstVector( V ); break;
+		case FOLD_Add_RotatorRotator:		R = Left.RotationBytes + Right.RotationBytes; Result.SetConstRotation( R ); break;
+		case FOLD_Subtract_RotatorRotator:	R = Left.RotationBytes - Right.RotationBytes; Result.SetConstRotation( R ); break;
+		default:
+			return FALSE;
+	}
+
+	// Replace the operands with the result.
+	Script.Remove( StartOfExpression.CodeTop, Script.Num()-StartOfExpression.CodeTop );
+	EmitConstant( Result );
+	return TRUE;
+}
+
 
 TMap<UFunction*,INT> FuncEmitCountMap;
 
@@ -1050,7 +1290,9 @@ TMap<UFunction*,INT> FuncEmitCountMap;
  */
 void FScriptCompiler::EmitStackNodeLinkFunction( UFunction* Node, UBOOL ForceFinal, UBOOL Global, UProperty *DelegateProp )
 {
-	UBOOL IsFinal = (Node->FunctionFlags & FUNC_Final) || ForceFinal;
+	UBOOL IsFinal = (Node->FunctionFlags & FUNC_Final) || ForceFinal || CanDevirtualize(Node);
+
+	RecordPerfLintSite( PERFLINT_Call, Node );
 
 	/*if (IsFinal && Node->iNative)
 	{
@@ -1380,40 +1622,57 @@ UBOOL FScriptCompiler::GetToken( FToken& Token, const FPropertyBase* Hint/*=NULL
 {
 	guard(::GetToken);
 	Token.TokenName	= NAME_None;
-	TCHAR c = GetLeadingChar();
-	TCHAR p = PeekChar();
+
+	// Reuse the raw token if this text was already lexed; only const interpretation remains.
+	const INT LexPos = InputPos;
+	const UBOOL bLexed = GetLexedToken( Token, LexPos, NoConsts );
+	if( bLexed && (Token.TokenType==TOKEN_Symbol || NoConsts) )
+	{
+		return TRUE;
+	}
+
+	TCHAR c = bLexed ? Token.Identifier[0] : GetLeadingChar();
+	TCHAR p = bLexed ? 0 : PeekChar();
 	if( c == 0 )
 	{
 		UngetChar();
 		return 0;
 	}
-	Token.StartPos		= PrevPos;
-	Token.StartLine		= PrevLine;
+	if( !bLexed )
+	{
+		Token.StartPos		= PrevPos;
+		Token.StartLine		= PrevLine;
+	}
 	if( (c>='A' && c<='Z') || (c>='a' && c<='z') || (c=='_') )
 	{
-		// Alphanumeric token.
-		INT Length=0;
-		TCHAR* TempIdent = appStaticString1024();
-		do
+		if( !bLexed )
 		{
-			TempIdent[Length++] = c;
-			if( Length >= NAME_SIZE )
+			// Alphanumeric token.
+			INT Length=0;
+			TCHAR* TempIdent = appStaticString1024();
+			do
 			{
-				ScriptErrorf(SCEL_Limit,  TEXT("Identifer length exceeds maximum of %i"), (INT)NAME_SIZE);
-				Length = ((INT)NAME_SIZE) - 1;
-				break;
-			}
-			c = GetChar();
-		} while( ((c>='A')&&(c<='Z')) || ((c>='a')&&(c<='z')) || ((c>='0')&&(c<='9')) || (c=='_') );
-		UngetChar();
-		TempIdent[Length] = 0;
-		Token.Identifier = TempIdent;
+				TempIdent[Length++] = c;
+				if( Length >= NAME_SIZE )
+				{
+					ScriptErrorf(SCEL_Limit,  TEXT("Identifer length exceeds maximum of %i"), (INT)NAME_SIZE);
+					Length = ((INT)NAME_SIZE) - 1;
+					break;
+				}
+				c = GetChar();
+			} while( ((c>='A')&&(c<='Z')) || ((c>='a')&&(c<='z')) || ((c>='0')&&(c<='9')) || (c=='_') );
+			UngetChar();
+			TempIdent[Length] = 0;
+			Token.Identifier = TempIdent;
 
-		// Assume this is an identifier unless we find otherwise.
-		Token.TokenType = TOKEN_Identifier;
+			// Assume this is an identifier unless we find otherwise.
+			Token.TokenType = TOKEN_Identifier;
 
-		// Lookup the token's global name.
-		Token.TokenName = FName(TempIdent, FNAME_Find);
+			// Lookup the token's global name.
+			Token.TokenName = FName(TempIdent, FNAME_Find);
+
+			StoreLexedToken( Token, LexPos, NoConsts );
+		}
 
 		// If const values are allowed, determine whether the identifier represents a constant
 		if ( !NoConsts )
@@ -1855,6 +2114,7 @@ UBOOL FScriptCompiler::GetToken( FToken& Token, const FPropertyBase* Hint/*=NULL
 		// Lookup the token's global name.
 		Token.TokenName = FName(TIdent, FNAME_Find);
 
+		StoreLexedToken( Token, LexPos, NoConsts );
 		return TRUE;
 	}
 	unguard;
@@ -2319,21 +2579,19 @@ UField* FScriptCompiler::FindField
 			UStruct* OriginalScope = Scope;
 			for( Scope; Scope; Scope=Cast<UStruct>( Scope->GetOuter()) )
 			{
-				for( TFieldIterator<UField> It(Scope, bIncludeParents); It; ++It )
+				UField* Field = FindScopeField( Scope, InName, bIncludeParents );
+				if( Field )
 				{
-					if( It->GetFieldName()==InName )
+					NLogf((TEXT("FOUND = %ls"), Field->GetFullName()));
+					if( !Field->IsA(FieldClass) )
 					{
-						NLogf((TEXT("FOUND = %ls"), It->GetFullName()));
-						if( !It->IsA(FieldClass) )
+						if( Thing && !bSearchingOuterContext )
 						{
-							if( Thing && !bSearchingOuterContext )
-							{
-								ScriptErrorf(SCEL_NestLevel,  TEXT("%s: expecting %s, got %s"), Thing, FieldClass->GetName(), It->GetClass()->GetName() );
-							}
-							return NULL;
+							ScriptErrorf(SCEL_NestLevel,  TEXT("%s: expecting %s, got %s"), Thing, FieldClass->GetName(), Field->GetClass()->GetName() );
 						}
-						return *It;
+						return NULL;
 					}
+					return Field;
 				}
 			}
 
@@ -2357,6 +2615,168 @@ UField* FScriptCompiler::FindField
 	return NULL;
 }
 
+/**
+ * Find the first field named InName declared in Struct or, if bIncludeParents is set, in one
+ * of its super structs.  Same result as walking TFieldIterator<UField>, but each struct is a
+ * single hash probe.  A struct's table is rebuilt on its next use whenever its Children list
+ * head changes; insertions further down the list must call InvalidateFieldNames.
+ */
+UField* FScriptCompiler::FindScopeField( UStruct* Struct, FName InName, UBOOL bIncludeParents )
+{
+	for( ; Struct; Struct=bIncludeParents ? Struct->GetInheritanceSuper() : NULL )
+	{
+		FFieldNameTable** ExistingTable = FieldNameTables.Find( Struct );
+		FFieldNameTable* Table = ExistingTable ? *ExistingTable : FieldNameTables.Set( Struct, new FFieldNameTable );
+		if( !Table->Fields.Num() || Table->Children!=Struct->Children )
+		{
+			Table->Children = Struct->Children;
+			Table->Fields.Empty();
+			for( UField* Field=Struct->Children; Field; Field=Field->Next )
+			{
+				// Earlier fields hide later ones with the same name, as with TFieldIterator.
+				const FName FieldName = Field->GetFieldName();
+				if( !Table->Fields.Find(FieldName) )
+				{
+					Table->Fields.Set( FieldName, Field );
+				}
+			}
+		}
+		UField** Found = Table->Fields.Find( InName );
+		if( Found )
+		{
+			return *Found;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Gather the operator functions named Operator with the given operator flags that are visible
+ * from the current nest chain.  The result is remembered per chain until an operator is declared.
+ */
+const FOperatorCandidates& FScriptCompiler::GetOperatorCandidates( FName Operator, DWORD FunctionFlags )
+{
+	const FOperatorLookupKey Key( NestLevel>=2 ? Nest[NestLevel-1].Node : NULL, Operator, FunctionFlags );
+	FOperatorCandidates* Candidates = OperatorCandidates.Find( Key );
+	if( Candidates )
+	{
+		// The innermost node nearly always implies the chain, but make sure.
+		UBOOL bSameScopes = Candidates->Scopes.Num()==Max(NestLevel-1,0);
+		for( INT i=NestLevel-1; bSameScopes && i>=1; i-- )
+		{
+			bSameScopes = Candidates->Scopes(NestLevel-1-i)==Nest[i].Node;
+		}
+		if( bSameScopes )
+		{
+			return *Candidates;
+		}
+	}
+
+	FOperatorCandidates NewCandidates;
+	NewCandidates.Precedence			= 0;
+	NewCandidates.NumParms				= 3;
+	NewCandidates.bAffectorOperation	= 0;
+	for( INT i=NestLevel-1; i>=1; i-- )
+	{
+		NewCandidates.Scopes.AddItem( Nest[i].Node );
+		for( TFieldIterator<UFunction> It(Nest[i].Node); It; ++It )
+		{
+			UFunction* OperFunction = *It;
+			if
+			(	OperFunction->FriendlyName==Operator
+			&&	FunctionFlags==(OperFunction->FunctionFlags & (FUNC_PreOperator|FUNC_Operator)) )
+			{
+				// Add this operator to the list.
+				NewCandidates.Functions.AddItem( OperFunction );
+				NewCandidates.Precedence = OperFunction->OperPrecedence;
+				NewCandidates.NumParms   = Min(NewCandidates.NumParms,(INT)OperFunction->NumParms);
+				if ( !NewCandidates.bAffectorOperation && OperFunction->NumParms > 1 &&
+					((((UProperty*)OperFunction->Children)->PropertyFlags & CPF_OutParm) != 0) )
+				{
+					NewCandidates.bAffectorOperation = 1;
+				}
+			}
+		}
+	}
+	return OperatorCandidates.Set( Key, NewCandidates );
+}
+
+/**
+ * Discard the field lookup for Struct after its fields were changed in place.
+ */
+void FScriptCompiler::InvalidateFieldNames( UStruct* Struct )
+{
+	FFieldNameTable** ExistingTable = FieldNameTables.Find( Struct );
+	if( ExistingTable )
+	{
+		(*ExistingTable)->Children = NULL;
+		(*ExistingTable)->Fields.Empty();
+	}
+}
+
+/**
+ * Whether calls to Function can be bound at compile time because nothing loaded can override it.
+ * Only functions of classes in DevirtualizePackages qualify; those packages must not be extended
+ * by anything compiled or loaded later.  An override in any state of a related class, or in any
+ * subclass, keeps the call virtual.
+ */
+UBOOL FScriptCompiler::CanDevirtualize( UFunction* Function )
+{
+	if
+	(	Pass!=PASS_Compile
+	||	GEditor->DevirtualizePackages.Num()==0
+	||	(Function->FunctionFlags & (FUNC_Final|FUNC_Native|FUNC_Event|FUNC_Delegate|FUNC_Operator|FUNC_PreOperator))
+	||	Function->iNative )
+	{
+		return FALSE;
+	}
+	UBOOL* Known = DevirtualizedFunctions.Find( Function );
+	if( Known )
+	{
+		return *Known;
+	}
+
+	UBOOL Result = FALSE;
+	UClass* OwnerClass = Cast<UClass>(Function->GetOuter());
+	if
+	(	OwnerClass
+	&&	!(OwnerClass->ClassFlags & CLASS_Interface)
+	&&	GEditor->DevirtualizePackages.FindItemIndex(OwnerClass->GetOutermost()->GetName())!=INDEX_NONE )
+	{
+		if( FunctionsByName.Num()==0 )
+		{
+			for( TObjectIterator<UFunction> It; It; ++It )
+			{
+				FunctionsByName.Add( It->FriendlyName, *It );
+			}
+		}
+		TArray<UFunction*> Others;
+		FunctionsByName.MultiFind( Function->FriendlyName, Others );
+		Result = TRUE;
+		for( INT i=0; Result && i<Others.Num(); i++ )
+		{
+			UFunction* Other = Others(i);
+			if( Other==Function )
+			{
+				continue;
+			}
+			UClass* OtherClass = Other->GetOwnerClass();
+			if( Other->GetOuter()->IsA(UClass::StaticClass()) )
+			{
+				// Versions declared higher up the hierarchy are already hidden by Function.
+				Result = !OtherClass->IsChildOf(OwnerClass);
+			}
+			else
+			{
+				// A state version takes over whenever the object is in that state.
+				Result = !OtherClass->IsChildOf(OwnerClass) && !OwnerClass->IsChildOf(OtherClass);
+			}
+		}
+	}
+	DevirtualizedFunctions.Set( Function, Result );
+	return Result;
+}
+
 // Check if a field obscures a field in an outer scope.
 void FScriptCompiler::CheckObscures( UStruct* Scope, FToken& Token )
 {
@@ -2579,6 +2999,7 @@ UEnum* FScriptCompiler::CompileEnum( UStruct* Scope, UBOOL& NeedSemicolon )
 		ScriptErrorf(SCEL_Restricted, TEXT("Illegal enumeration tag specified.  Conflicts with auto-generated tag '%s'"), *MaxEnumItem);
 		///return NULL;
 	}
+	GEditor->AddEnumValues(Enum);
 
 	return Enum;
 }
@@ -5534,6 +5955,7 @@ UBOOL FScriptCompiler::CompileExpr
 					{
 						Writer << EX_DynArrayFind;
 					}
+					RecordPerfLintSite( PERFLINT_ArrayFind, NULL );
 					MoveCompiledCode( StartOfExpression, HighRetry );
 
 
@@ -6030,27 +6452,11 @@ Test:
 			UBOOL bAffectorOperation = 0;
 
 			// Build a list of matching operators.
-			for( INT i=NestLevel-1; i>=1; i-- )
-			{
-				for( TFieldIterator<UFunction> It(Nest[i].Node); It; ++It )
-				{
-					UFunction* OperFunction = *It;
-					if
-					(	OperFunction->FriendlyName==OperToken.TokenName
-					&&	RequiredFunctionFlags==(OperFunction->FunctionFlags & (FUNC_PreOperator|FUNC_Operator)) )
-					{
-						// Add this operator to the list.
-						OperLinks.AddItem( OperFunction );
-						Precedence = OperFunction->OperPrecedence;
-						NumParms   = Min(NumParms,(INT)OperFunction->NumParms);
-						if ( !bAffectorOperation && OperFunction->NumParms > 1 &&
-							((((UProperty*)OperFunction->Children)->PropertyFlags & CPF_OutParm) != 0) )
-						{
-							bAffectorOperation = 1;
-						}
-					}
-				}
-			}
+			const FOperatorCandidates& Candidates = GetOperatorCandidates( OperToken.TokenName, RequiredFunctionFlags );
+			OperLinks			= Candidates.Functions;
+			Precedence			= Candidates.Precedence;
+			NumParms			= Candidates.NumParms;
+			bAffectorOperation	= Candidates.bAffectorOperation;
 
 			// See if we got a valid operator, and if we want to handle it at the current precedence level.
 			if( OperLinks.Num()>0 && Precedence<MaxPrecedence )
@@ -6409,6 +6815,14 @@ Test:
 						}
 					}
 
+					// Evaluate operators on constants right away.
+					FToken FoldedToken;
+					if( FoldConstantOperator(BestOperLink, IsPreOperator, Token, NewResultType, StartOfExpression, MidRetry, FoldedToken) )
+					{
+						Token = FoldedToken;
+						goto Test;
+					}
+
 					// Convert Expr2 if necessary.
 					if( BestOperLink->NumParms==3 || IsPreOperator )
 					{
@@ -9079,6 +9493,7 @@ UProperty* FScriptCompiler::GetVarNameAndDim
 			NewProperty->Next = Scope->Children;
 			Scope->Children = NewProperty;
 		}
+		InvalidateFieldNames( Scope );
 	}
 
 	if ( !Skip )
@@ -10007,6 +10422,7 @@ void FScriptCompiler::CompileClassDeclaration( FToken& Token, UBOOL& NeedSemicol
 	Class->Script.Empty();
 	Class->Children			= NULL;
 	Class->Next				= NULL;
+	InvalidateFieldNames( Class );
 	Class->ProbeMask        = 0;
 	Class->StateFlags       = 0;
 	Class->LabelTableOffset = 0;
@@ -10258,6 +10674,7 @@ void FScriptCompiler::CompileInterfaceDeclaration( FToken& Token, UBOOL& NeedSem
 	Class->Script.Empty();
 	Class->Children			= NULL;
 	Class->Next				= NULL;
+	InvalidateFieldNames( Class );
 	Class->ProbeMask        = 0;
 	Class->StateFlags       = 0;
 	Class->LabelTableOffset = 0;
@@ -10873,6 +11290,7 @@ void FScriptCompiler::CompileFunctionDeclaration( FToken& Token, UBOOL& NeedSemi
 			TopFunction->AltName = TopFunction->FriendlyName;
 			TopFunction->Rename(UEditor::GetObscNameUnique(TopFunction->GetOuter()));
 			TopFunction->FriendlyName = TopFunction->GetFName();
+			InvalidateFieldNames( CastChecked<UStruct>(TopFunction->GetOuter()) );
 		}
 	}
 	FuncInfo.FunctionReference   = TopFunction;
@@ -11040,6 +11458,9 @@ void FScriptCompiler::CompileFunctionDeclaration( FToken& Token, UBOOL& NeedSemi
 		{
 			ScriptErrorf(SCEL_Restricted,  TEXT("Operators must be declared as 'Final'") );
 		}
+
+		// The new operator may change overload resolution anywhere it's visible.
+		OperatorCandidates.Empty();
 	}
 
 	// Make new UDelegateProperty for delegate
@@ -11070,6 +11491,7 @@ void FScriptCompiler::CompileFunctionDeclaration( FToken& Token, UBOOL& NeedSemi
 			NewProperty->Next = Scope->Children;
 			Scope->Children = NewProperty;
 		}
+		InvalidateFieldNames( Scope );
 	}
 
 	// determine whether this function should be exported as 'const'
@@ -12305,6 +12727,7 @@ void FScriptCompiler::CompileCommand( FToken& Token, UBOOL& NeedSemicolon )
 	else if( Token.Matches(NAME_Assert) )
 	{
 		CheckAllow( TEXT("'Assert'"), ALLOW_Cmd );
+		const INT AssertStart = TopNode->Script.Num();
 		EmitDebugInfo(DI_Assert);
 		WORD wLine = InputLine;
 		Writer << EX_Assert;
@@ -12314,6 +12737,11 @@ void FScriptCompiler::CompileCommand( FToken& Token, UBOOL& NeedSemicolon )
 		Writer << bDebug;
 		// write the expression to be evaluated
 		CompileExpr( FPropertyBase(CPT_Bool,CPRT_SimpleReference), TEXT("'Assert'") );
+		if( GEditor->bReleaseBuild )
+		{
+			// Release packages don't evaluate asserts at all.
+			TopNode->Script.Remove( AssertStart, TopNode->Script.Num()-AssertStart );
+		}
 	}
 	else if( Token.Matches(NAME_Goto) )
 	{
@@ -13010,28 +13438,25 @@ void FScriptCompiler::CompileSecondPass( UStruct* Node )
 
 					// Find variable.
 					UBOOL Found=0;
-					for( TFieldIterator<UProperty> It(Class); It && It.GetStruct()==Class; ++It )
+					UProperty* Property = Cast<UProperty>(FindScopeField( Class, VarName, FALSE ));
+					if( Property )
 					{
-						if( It->GetFName()==VarName )
+						// Found it, so make sure it's replicatable.
+						if( (Property->PropertyFlags & CPF_Net) != 0 )
 						{
-							// Found it, so make sure it's replicatable.
-							if( (It->PropertyFlags & CPF_Net) != 0 )
-							{
-								ScriptErrorf(SCEL_Restricted,  TEXT("Variable '%s' already has a replication definition"), *VarName );
-							}
-
-							// Make sure it isn't a dynamic array property
-							if ( It->IsA(UArrayProperty::StaticClass()) )
-							{
-								ScriptErrorf(SCEL_Restricted, TEXT("Dynamic arrays cannot be replicated '%s'"), *VarName);
-							}
+							ScriptErrorf(SCEL_Restricted,  TEXT("Variable '%s' already has a replication definition"), *VarName );
+						}
 
-							// Set its properties.
-							It->PropertyFlags |= CPF_Net;
-							It->RepOffset = RepOffset;
-							Found = 1;
-							break;
+						// Make sure it isn't a dynamic array property
+						if ( Property->IsA(UArrayProperty::StaticClass()) )
+						{
+							ScriptErrorf(SCEL_Restricted, TEXT("Dynamic arrays cannot be replicated '%s'"), *VarName);
 						}
+
+						// Set its properties.
+						Property->PropertyFlags |= CPF_Net;
+						Property->RepOffset = RepOffset;
+						Found = 1;
 					}
 					if( !Found )
 					{
@@ -13224,7 +13649,7 @@ UBOOL FScriptCompiler::CompileScript
 
 	//!! Debugger
 	SupressDebugInfo = 0;
-	bEmitDebugInfo = ParseParam( appCmdLine(), TEXT("DEBUG") );
+	bEmitDebugInfo = ParseParam( appCmdLine(), TEXT("DEBUG") ) && !GEditor->bReleaseBuild;
 
 	//!! Debugger
 	// Message.
@@ -13316,6 +13741,17 @@ UBOOL FScriptCompiler::CompileScript
 	PrevPos		  = 0;
 	PrevLine	  = 1;
 	InputLine     = 1;
+
+	// Pick up the tokens earlier passes lexed from this class, unless its text changed since.
+	FLexedTokenCache** ExistingTokens = LexedTokens.Find( Class );
+	CurrentLexedTokens = ExistingTokens ? *ExistingTokens : LexedTokens.Set( Class, new FLexedTokenCache );
+	if( CurrentLexedTokens->Input!=Input || CurrentLexedTokens->InputLen!=InputLen )
+	{
+		CurrentLexedTokens->Input		= Input;
+		CurrentLexedTokens->InputLen	= InputLen;
+		CurrentLexedTokens->Tokens.Empty();
+	}
+
 	// Init nesting.
 	NestLevel	= 0;
 	TopNest		= NULL;
@@ -13571,9 +14007,141 @@ void FScriptCompiler::AddResultText(const TCHAR* Fmt, ...)
 -----------------------------------------------------------------------------*/
 
 /**
- * Parse Class's unrealscript and optionally its child classes.  Marks the class as CLASS_Parsed.
- *
- * @param	AllClasses		the class tree containing all classes in the current package
+ * Dependency graph over the classes being compiled, built once before parsing.  Each class
+ * depends on its DependsOn/Implements classes and on its superclass.  Tarjan's strongly
+ * connected components give both the parse order, dependencies first, and the circular
+ * dependencies, which are exactly the classes sharing a component.
+ */
+class FClassDependencyGraph
+{
+public:
+	/** Classes in the order they should be parsed, dependencies before dependents. */
+	TArray<UClass*>	ParseOrder;
+
+	FClassDependencyGraph( const TArray<UClass*>& InClasses )
+	: Classes(InClasses)
+	, NextVisitIndex(0)
+	, NumComponents(0)
+	{
+		guard(FClassDependencyGraph::FClassDependencyGraph);
+		for( INT i=0; i<Classes.Num(); i++ )
+		{
+			ClassIndices.Set( Classes(i), i );
+		}
+
+		// Flatten the edges, DependsOn entries first and the superclass last, as ParseScripts visits them.
+		FirstEdge.Add( Classes.Num()+1 );
+		for( INT i=0; i<Classes.Num(); i++ )
+		{
+			UClass* Class = Classes(i);
+			FirstEdge(i) = Edges.Num();
+			for( INT NameIndex=0; NameIndex<Class->DependentOn.Num(); NameIndex++ )
+			{
+				UClass* Dependency = FindClass(*Class->DependentOn(NameIndex));
+
+				// A native class whose parent changed lists the new parent as a dependency; that edge is added below.
+				if( Dependency && Dependency!=Class->GetSuperClass() )
+				{
+					AddEdge( Dependency );
+				}
+			}
+			AddEdge( Class->GetSuperClass() );
+		}
+		FirstEdge(Classes.Num()) = Edges.Num();
+
+		VisitIndex.Add( Classes.Num() );
+		LowLink.Add( Classes.Num() );
+		Components.Add( Classes.Num() );
+		for( INT i=0; i<Classes.Num(); i++ )
+		{
+			VisitIndex(i) = INDEX_NONE;
+		}
+		for( INT i=0; i<Classes.Num(); i++ )
+		{
+			if( VisitIndex(i)==INDEX_NONE )
+			{
+				Visit( i );
+			}
+		}
+		unguard;
+	}
+
+	/** Whether Class is one of the classes being compiled. */
+	UBOOL Contains( UClass* Class ) const
+	{
+		return ClassIndices.Find(Class)!=NULL;
+	}
+
+	/** Whether two different classes depend on each other, directly or through other classes. */
+	UBOOL IsCircular( UClass* A, UClass* B ) const
+	{
+		const INT* IndexA = ClassIndices.Find(A);
+		const INT* IndexB = ClassIndices.Find(B);
+		return IndexA && IndexB && *IndexA!=*IndexB && Components(*IndexA)==Components(*IndexB);
+	}
+
+private:
+	const TArray<UClass*>&	Classes;
+	TMap<UClass*,INT>		ClassIndices;
+	TArray<INT>				FirstEdge;		// Class index -> first entry in Edges; one extra terminating entry.
+	TArray<INT>				Edges;			// Class indices depended upon.
+	TArray<INT>				VisitIndex;
+	TArray<INT>				LowLink;
+	TArray<INT>				Components;		// Class index -> strongly connected component.
+	TArray<INT>				Stack;
+	INT						NextVisitIndex;
+	INT						NumComponents;
+
+	void AddEdge( UClass* Dependency )
+	{
+		// Classes outside of this make are already parsed and can't depend back on ours.
+		const INT* DependencyIndex = Dependency ? ClassIndices.Find(Dependency) : NULL;
+		if( DependencyIndex )
+		{
+			Edges.AddItem( *DependencyIndex );
+		}
+	}
+
+	void Visit( INT Node )
+	{
+		VisitIndex(Node) = LowLink(Node) = NextVisitIndex++;
+		Components(Node) = INDEX_NONE;
+		Stack.AddItem( Node );
+		for( INT EdgeIndex=FirstEdge(Node); EdgeIndex<FirstEdge(Node+1); EdgeIndex++ )
+		{
+			const INT Dependency = Edges(EdgeIndex);
+			if( VisitIndex(Dependency)==INDEX_NONE )
+			{
+				Visit( Dependency );
+				LowLink(Node) = Min( LowLink(Node), LowLink(Dependency) );
+			}
+			else if( Components(Dependency)==INDEX_NONE )
+			{
+				// Still on the stack.
+				LowLink(Node) = Min( LowLink(Node), VisitIndex(Dependency) );
+			}
+		}
+		if( LowLink(Node)==VisitIndex(Node) )
+		{
+			// Node roots a component; every dependency outside of it has already been emitted.
+			INT Member;
+			do
+			{
+				Member = Stack.Pop();
+				Components(Member) = NumComponents;
+				ParseOrder.AddItem( Classes(Member) );
+			}
+			while( Member!=Node );
+			NumComponents++;
+		}
+	}
+};
+
+/**
+ * Parse Class's unrealscript and optionally its child classes.  Marks the class as CLASS_Parsed.
+ *
+ * @param	AllClasses		the class tree containing all classes in the current package
+ * @param	Graph			dependency graph over AllClasses
  * @param	Compiler		the script compiler
  * @param	Class			the class to parse
  * @param	MakeAll			whether to parse classes even if they are already parsed
@@ -13582,7 +14150,7 @@ void FScriptCompiler::AddResultText(const TCHAR* Fmt, ...)
  *
  * @return	TRUE if the class was successfully compiled, FALSE otherwise
  */
-static UBOOL ParseScripts( UClass* Class, TArray<UClass*>& AllClasses, FScriptCompiler& Compiler )
+static UBOOL ParseScripts( UClass* Class, TArray<UClass*>& AllClasses, const FClassDependencyGraph& Graph, FScriptCompiler& Compiler )
 {
 	if (!Class->ScriptText)
 		return TRUE;
@@ -13615,11 +14183,16 @@ static UBOOL ParseScripts( UClass* Class, TArray<UClass*>& AllClasses, FScriptCo
 			}
 
 			// Check for circular dependency. If the OrigDependsOnClass is dependent on the SubClass, there is one.
-			if (Compiler.IsDependentOn(OrigDependsOnClass, Class, AllClasses))
+			if (Graph.IsCircular(OrigDependsOnClass, Class))
 			{
 				Compiler.ScriptErrorf(SCEL_Class, TEXT("Class %s DependsOn(%s) is a circular dependency."), OrigDependsOnClass->GetName(), Class->GetName());
 				return FALSE;
 			}
+			if (!OrigDependsOnClass->HasAnyClassFlags(CLASS_Interface) && !Graph.Contains(OrigDependsOnClass))
+			{
+				Compiler.ScriptErrorf(SCEL_Parse, TEXT("Unparsed class '%s' found while validating DependsOn entries for '%s'"), OrigDependsOnClass->GetName(), Class->GetName());
+				return FALSE;
+			}
 
 
 			// Find first base class of DependsOnClass that is not a base class of Class.
@@ -13634,7 +14207,7 @@ static UBOOL ParseScripts( UClass* Class, TArray<UClass*>& AllClasses, FScriptCo
 			while (ClassesToParse.Num() > 0)
 			{
 				UClass* NextClass = ClassesToParse.Pop();
-				if (ParseScripts(NextClass, AllClasses, Compiler))
+				if (ParseScripts(NextClass, AllClasses, Graph, Compiler))
 				{
 					break;
 				}
@@ -13653,7 +14226,7 @@ static UBOOL ParseScripts( UClass* Class, TArray<UClass*>& AllClasses, FScriptCo
 		UClass* CurrentSuperClass = Class->GetSuperClass();
 
 		// Compile parent class if not yet done.
-		if (CurrentSuperClass && !(CurrentSuperClass->ClassFlags & CLASS_Parsed) && AllClasses.FindItemIndex(CurrentSuperClass)>=0 && !ParseScripts(CurrentSuperClass, AllClasses, Compiler))
+		if (CurrentSuperClass && !(CurrentSuperClass->ClassFlags & CLASS_Parsed) && Graph.Contains(CurrentSuperClass) && !ParseScripts(CurrentSuperClass, AllClasses, Graph, Compiler))
 			return FALSE;
 
 		if (!Compiler.CompileScript(AllClasses, Class, &GMem, 1, PASS_Parse))
@@ -13699,6 +14272,399 @@ static UBOOL CompileScripts( TArray<UClass*>& AllClasses, FScriptCompiler& Compi
 	unguard;
 }
 
+/**
+ * Walk the top-level statements of Function's bytecode.
+ *
+ * @param	Statements	[out] code offset of each statement, in order
+ * @return	TRUE if the walk ended exactly at the end of the script
+ */
+static UBOOL GetScriptStatements( UFunction* Function, TArray<INT>& Statements )
+{
+	FArchive DummyAr;
+	INT iCode = 0;
+	Statements.Empty();
+	while( iCode < Function->Script.Num() )
+	{
+		Statements.AddItem( iCode );
+		Function->SerializeExpr( iCode, DummyAr );
+	}
+	return iCode==Function->Script.Num();
+}
+
+static CodeSkipSizeType GetCodeOffset( const TArray<BYTE>& Script, INT iCode )
+{
+	CodeSkipSizeType Offset;
+	appMemcpy( &Offset, &Script(iCode), sizeof(CodeSkipSizeType) );
+	return Offset;
+}
+
+static void SetCodeOffset( TArray<BYTE>& Script, INT iCode, CodeSkipSizeType Offset )
+{
+	appMemcpy( &Script(iCode), &Offset, sizeof(CodeSkipSizeType) );
+}
+
+/**
+ * Peephole pass over a compiled function.  Conditional jumps on a literal True or False become
+ * plain jumps, and jumps landing on another jump go straight to its destination.  Statements
+ * keep their size and position, so no other code offset needs fixing up.  The result must walk
+ * back cleanly through SerializeExpr or the original code is restored.
+ *
+ * @return	number of statements rewritten
+ */
+static INT OptimizeFunctionCode( UFunction* Function )
+{
+	TArray<BYTE>& Script = Function->Script;
+	TArray<INT> Statements;
+	if( !GetScriptStatements(Function, Statements) )
+	{
+		return 0;
+	}
+	TArray<BYTE> OriginalScript = Script;
+	TArray<BYTE> IsStatement;
+	IsStatement.AddZeroed( Script.Num() );
+	for( INT i=0; i<Statements.Num(); i++ )
+	{
+		IsStatement(Statements(i)) = 1;
+	}
+
+	const INT JumpSize = 1 + sizeof(CodeSkipSizeType);
+	INT NumChanged = 0;
+
+	// Constant conditions, i.e. while(true) and if(false).
+	for( INT i=0; i<Statements.Num(); i++ )
+	{
+		const INT iCode = Statements(i);
+		const INT iCondition = iCode + JumpSize;
+		if
+		(	Script(iCode)==EX_JumpIfNot
+		&&	iCondition<Script.Num()
+		&&	(Script(iCondition)==EX_True || Script(iCondition)==EX_False)
+		&&	(i+1==Statements.Num() ? Script.Num() : Statements(i+1))==iCondition+1 )
+		{
+			// Never taken on True, so jump just past the condition; always taken on False.
+			if( Script(iCondition)==EX_True )
+			{
+				SetCodeOffset( Script, iCode+1, iCondition+1 );
+			}
+			Script(iCode)		= EX_Jump;
+			Script(iCondition)	= EX_Nothing;
+			IsStatement(iCondition) = 1;
+			NumChanged++;
+		}
+	}
+
+	// Jump threading.
+	for( INT i=0; i<Statements.Num(); i++ )
+	{
+		const INT iCode = Statements(i);
+		if( Script(iCode)!=EX_Jump && Script(iCode)!=EX_JumpIfNot )
+		{
+			continue;
+		}
+		const CodeSkipSizeType OriginalTarget = GetCodeOffset( Script, iCode+1 );
+		CodeSkipSizeType Target = OriginalTarget;
+
+		// Bounded, so jump cycles such as an empty infinite loop can't hang us.
+		for( INT Hops=0; Hops<Statements.Num() && Target<Script.Num() && IsStatement(Target) && Script(Target)==EX_Jump; Hops++ )
+		{
+			const CodeSkipSizeType Next = GetCodeOffset( Script, Target+1 );
+			if( Next==Target )
+			{
+				break;
+			}
+			Target = Next;
+		}
+		if( Target!=OriginalTarget )
+		{
+			SetCodeOffset( Script, iCode+1, Target );
+			NumChanged++;
+		}
+	}
+
+	if( NumChanged )
+	{
+		TArray<INT> NewStatements;
+		if( !GetScriptStatements(Function, NewStatements) )
+		{
+			debugf( NAME_Warning, TEXT("Bytecode optimization of %ls failed verification, keeping original code"), Function->GetFullName() );
+			Script = OriginalScript;
+			return 0;
+		}
+	}
+	return NumChanged;
+}
+
+/**
+ * Run OptimizeFunctionCode over every function declared in Struct, including those in its states.
+ */
+static INT OptimizeStructCode( UStruct* Struct )
+{
+	INT NumChanged = 0;
+	for( UField* Field=Struct->Children; Field; Field=Field->Next )
+	{
+		if( Field->IsA(UFunction::StaticClass()) )
+		{
+			NumChanged += OptimizeFunctionCode( (UFunction*)Field );
+		}
+		else if( Field->IsA(UState::StaticClass()) )
+		{
+			NumChanged += OptimizeStructCode( (UState*)Field );
+		}
+	}
+	return NumChanged;
+}
+
+/*-----------------------------------------------------------------------------
+	Performance linter.
+-----------------------------------------------------------------------------*/
+
+/**
+ * Remember a call or expensive operation emitted into TopNode, for ReportPerfLint.  Calls to
+ * iterators, Spawn and the string concatenation operators are classified from Callee.
+ */
+void FScriptCompiler::RecordPerfLintSite( BYTE Kind, UFunction* Callee )
+{
+	if( !GEditor->bPerfLint || Pass!=PASS_Compile || !TopNode )
+	{
+		return;
+	}
+	if( Kind==PERFLINT_Call )
+	{
+		const FString Name = *Callee->FriendlyName;
+		if( Callee->HasAnyFunctionFlags(FUNC_Iterator) )
+		{
+			Kind = (Name==TEXT("AllActors") || Name==TEXT("DynamicActors")) ? PERFLINT_ActorIterator : PERFLINT_Iterator;
+		}
+		else if( Name==TEXT("Spawn") )
+		{
+			Kind = PERFLINT_Spawn;
+		}
+		else if
+		(	Callee->HasAnyFunctionFlags(FUNC_Operator)
+		&&	(Name==TEXT("$") || Name==TEXT("@") || Name==TEXT("$=") || Name==TEXT("@=")) )
+		{
+			Kind = PERFLINT_StringBuild;
+		}
+	}
+
+	// The foreach nest is already pushed while its iterator call is compiled.
+	INT LoopDepth = 0;
+	for( INT i=0; i<NestLevel; i++ )
+	{
+		const ENestType NestType = Nest[i].NestType;
+		if( NestType==NEST_Loop || NestType==NEST_For || NestType==NEST_ForEach )
+		{
+			LoopDepth++;
+		}
+	}
+	if( (Kind==PERFLINT_ActorIterator || Kind==PERFLINT_Iterator) && LoopDepth>0 )
+	{
+		LoopDepth--;
+	}
+
+	// Backtracking may compile the same expression again.
+	for( INT i=PerfLintSites.Num()-1; i>=0 && PerfLintSites(i).Caller==TopNode; i-- )
+	{
+		const FPerfLintSite& Site = PerfLintSites(i);
+		if( Site.Callee==Callee && Site.Line==InputLine && Site.Kind==Kind )
+		{
+			return;
+		}
+	}
+	FPerfLintSite* Site = new(PerfLintSites) FPerfLintSite;
+	Site->Caller	= TopNode;
+	Site->Callee	= Callee;
+	Site->Line		= InputLine;
+	Site->Kind		= Kind;
+	Site->LoopDepth	= Min(LoopDepth,255);
+}
+
+struct FPerfLintFinding
+{
+	INT			Cost;
+	INT			iSite;
+	UStruct*	Root;
+};
+
+static INT CDECL PerfLintFindingCompare( const FPerfLintFinding& A, const FPerfLintFinding& B )
+{
+	return A.Cost!=B.Cost ? B.Cost-A.Cost : A.iSite-B.iSite;
+}
+
+/** Points warnings at one line of a class source file. */
+class FPerfLintContext : public FContextSupplier
+{
+public:
+	UClass* Class;
+	INT Line;
+
+	FString GetContext()
+	{
+		return FString::Printf
+		(
+			TEXT("%ls\\%ls\\Classes\\%ls.uc(%i)"),
+			*GEditor->EditPackagesInPath,
+			Class->GetOuter()->GetName(),
+			Class->GetName(),
+			Line
+		);
+	}
+};
+
+static FString PerfLintJsonString( const FString& S )
+{
+	FString Result = TEXT("\"");
+	for( INT i=0; i<S.Len(); i++ )
+	{
+		const TCHAR C = S[i];
+		if( C==TEXT('\"') || C==TEXT('\\') )
+		{
+			Result += TEXT("\\");
+		}
+		if( C>=32 )
+		{
+			Result += FString::Chr(C);
+		}
+	}
+	return Result + TEXT("\"");
+}
+
+/**
+ * Walk the script call graph of Package from its per-frame entry points (Tick, PlayerTick, Timer
+ * and state code) and warn about the recorded sites they reach, most expensive first.  Calls follow
+ * overrides declared in the package.  Cost is a weight per kind of site, times 8 per enclosing loop.
+ * With PerfLintPath set, the findings are also written to <PerfLintPath>\<Package>_PerfLint.json.
+ */
+void FScriptCompiler::ReportPerfLint( UPackage* Package )
+{
+	guard(FScriptCompiler::ReportPerfLint);
+	static const INT KindWeights[] = { 0, 100, 10, 40, 5, 20 };
+	static const TCHAR* KindNames[] = { TEXT("call"), TEXT("actor iterator"), TEXT("iterator"), TEXT("spawn"), TEXT("string build"), TEXT("array find") };
+
+	TMultiMap<UStruct*,INT> SitesByCaller;
+	for( INT i=0; i<PerfLintSites.Num(); i++ )
+	{
+		SitesByCaller.Add( PerfLintSites(i).Caller, i );
+	}
+	TMultiMap<FName,UFunction*> FunctionsInPackage;
+	TArray<UStruct*> Pending;
+	TMap<UStruct*,UStruct*> ReachedFrom;
+	for( TObjectIterator<UStruct> It; It; ++It )
+	{
+		if( !It->IsIn(Package) )
+		{
+			continue;
+		}
+		UFunction* Function = Cast<UFunction>(*It);
+		if( Function )
+		{
+			FunctionsInPackage.Add( Function->FriendlyName, Function );
+			const FString Name = *Function->FriendlyName;
+			if( Name==TEXT("Tick") || Name==TEXT("PlayerTick") || Name==TEXT("Timer") )
+			{
+				Pending.AddItem( Function );
+				ReachedFrom.Set( Function, Function );
+			}
+		}
+		else if( It->IsA(UState::StaticClass()) && !It->IsA(UClass::StaticClass()) && It->Script.Num() )
+		{
+			Pending.AddItem( *It );
+			ReachedFrom.Set( *It, *It );
+		}
+	}
+
+	// Breadth first, so each function is attributed to the first entry point found.
+	for( INT iPending=0; iPending<Pending.Num(); iPending++ )
+	{
+		UStruct* Caller = Pending(iPending);
+		UStruct* Root = ReachedFrom.FindRef( Caller );
+		TArray<INT> Sites;
+		SitesByCaller.MultiFind( Caller, Sites );
+		for( INT i=0; i<Sites.Num(); i++ )
+		{
+			UFunction* Callee = PerfLintSites(Sites(i)).Callee;
+			if( !Callee )
+			{
+				continue;
+			}
+			TArray<UFunction*> Targets;
+			FunctionsInPackage.MultiFind( Callee->FriendlyName, Targets );
+			for( INT j=0; j<Targets.Num(); j++ )
+			{
+				UFunction* Target = Targets(j);
+				if
+				(	!ReachedFrom.Find(Target)
+				&&	(Target==Callee || Target->GetOwnerClass()->IsChildOf(Callee->GetOwnerClass())) )
+				{
+					Pending.AddItem( Target );
+					ReachedFrom.Set( Target, Root );
+				}
+			}
+		}
+	}
+
+	TArray<FPerfLintFinding> Findings;
+	for( INT i=0; i<PerfLintSites.Num(); i++ )
+	{
+		const FPerfLintSite& Site = PerfLintSites(i);
+		UStruct** Root = ReachedFrom.Find( Site.Caller );
+		if( !Root || Site.Kind==PERFLINT_Call || (Site.Kind==PERFLINT_ArrayFind && !Site.LoopDepth) )
+		{
+			continue;
+		}
+		FPerfLintFinding* Finding = new(Findings) FPerfLintFinding;
+		Finding->Cost	= KindWeights[Site.Kind] << (3*Min<INT>(Site.LoopDepth,3));
+		Finding->iSite	= i;
+		Finding->Root	= *Root;
+	}
+	if( Findings.Num() )
+	{
+		appQsort( &Findings(0), Findings.Num(), sizeof(FPerfLintFinding), (QSORT_COMPARE)PerfLintFindingCompare );
+	}
+
+	FPerfLintContext Context;
+	FString Json = TEXT("[\r\n");
+	for( INT i=0; i<Findings.Num(); i++ )
+	{
+		const FPerfLintFinding& Finding = Findings(i);
+		const FPerfLintSite& Site = PerfLintSites(Finding.iSite);
+		const FString What = Site.Callee ? FString::Printf(TEXT("%ls '%ls'"), KindNames[Site.Kind], *Site.Callee->FriendlyName) : FString(KindNames[Site.Kind]);
+		const FString Entry = Finding.Root->IsA(UFunction::StaticClass())
+			? FString::Printf(TEXT("%ls.%ls"), Finding.Root->GetOwnerClass()->GetName(), Finding.Root->GetName())
+			: FString::Printf(TEXT("%ls state %ls"), Finding.Root->GetOwnerClass()->GetName(), Finding.Root->GetName());
+
+		Context.Class	= Site.Caller->GetOwnerClass();
+		Context.Line	= Site.Line;
+		Warn->SetContext( &Context );
+		ScriptWarnf( SCWL_Level1, TEXT("Performance: %ls in %ls (cost %i), reached every frame from %ls"), *What, Site.Caller->GetName(), Finding.Cost, *Entry );
+
+		Json += FString::Printf
+		(
+			TEXT("  {\"cost\": %i, \"kind\": %ls, \"file\": %ls, \"function\": %ls, \"entry\": %ls}%ls\r\n"),
+			Finding.Cost,
+			*PerfLintJsonString(KindNames[Site.Kind]),
+			*PerfLintJsonString(Context.GetContext()),
+			*PerfLintJsonString(Site.Caller->GetPathName()),
+			*PerfLintJsonString(Entry),
+			i+1<Findings.Num() ? TEXT(",") : TEXT("")
+		);
+	}
+	Warn->SetContext( NULL );
+	Json += TEXT("]\r\n");
+	debugf( TEXT("Performance linter: %i finding(s) in %ls"), Findings.Num(), Package->GetName() );
+
+	if( GEditor->PerfLintPath.Len() )
+	{
+		GFileManager->MakeDirectory( *GEditor->PerfLintPath, 1 );
+		const FString ReportFile = GEditor->PerfLintPath * Package->GetName() + TEXT("_PerfLint.json");
+		if( !appSaveStringToFile(Json, *ReportFile) )
+		{
+			GWarn->Logf( NAME_Warning, TEXT("Couldn't write %ls"), *ReportFile );
+		}
+	}
+	unguard;
+}
+
 static INT CountClassesWithUnparsedDefaults( const TArray<UClass*>& AllClasses )
 {
 	INT Result = 0;
@@ -13785,6 +14751,96 @@ UBOOL UEditor::ImportDefaultProps(UClass* Class)
 	unguardf((TEXT("(%ls)"), Class->GetFullName()));
 }
 
+struct FClassDefaultsOrder
+{
+	UClass*	Class;
+	INT		Level;
+	INT		Index;
+};
+
+static INT CDECL ClassDefaultsOrderCompare( const FClassDefaultsOrder& A, const FClassDefaultsOrder& B )
+{
+	return A.Level!=B.Level ? A.Level - B.Level : A.Index - B.Index;
+}
+
+/** Longest chain of classes whose defaults have to be imported before Class's; INDEX_NONE while it's being visited. */
+static INT GetClassDefaultsLevel( UClass* Class, TMap<UClass*, TArray<UClass*> >& Dependencies, TMap<UClass*, INT>& Levels, UBOOL& bCycle )
+{
+	INT* Level = Levels.Find(Class);
+	if ( Level )
+	{
+		if ( *Level == INDEX_NONE )
+			bCycle = TRUE;
+		return *Level;
+	}
+	Levels.Set(Class, INDEX_NONE);
+	INT Result = 0;
+	const TArray<UClass*>& Required = *Dependencies.Find(Class);
+	for ( INT i=0; i<Required.Num(); i++ )
+		Result = Max(Result, GetClassDefaultsLevel(Required(i), Dependencies, Levels, bCycle) + 1);
+	Levels.Set(Class, Result);
+	return Result;
+}
+
+/**
+ * Orders the classes that still need their defaults imported so that every class comes after its superclass
+ * and after the classes of its BEGIN OBJECT templates, level by level (classes on the same level don't depend
+ * on each other) and in AllClasses order within a level, so the result is the same on every run.
+ *
+ * @return	FALSE if some dependency couldn't be ordered (a cycle, or a template class outside AllClasses that
+ *			still needs its defaults), in which case ImportDefaultProps has to resolve templates itself
+ */
+static UBOOL GetClassDefaultsOrder( const TArray<UClass*>& AllClasses, TArray<UClass*>& Order )
+{
+	guard(GetClassDefaultsOrder);
+	TMap<UClass*, TArray<UClass*> > Dependencies;
+	for ( INT i=0; i<AllClasses.Num(); i++ )
+		if ( AllClasses(i)->ClassFlags & CLASS_NeedsDefProps )
+			Dependencies.Set(AllClasses(i), TArray<UClass*>());
+
+	UBOOL bComplete = TRUE;
+	for ( TMap<UClass*, TArray<UClass*> >::TIterator It(Dependencies); It; ++It )
+	{
+		UClass* Class = It.Key();
+		TArray<UClass*> Required;
+		if ( Class->GetSuperClass() )
+			Required.AddItem(Class->GetSuperClass());
+		GetDefaultsTemplateClasses(*Class->DefaultPropText, Required);
+		for ( INT i=0; i<Required.Num(); i++ )
+		{
+			if ( Required(i)==Class || !(Required(i)->ClassFlags & CLASS_NeedsDefProps) )
+				continue;
+			if ( Dependencies.Find(Required(i)) )
+				It.Value().AddUniqueItem(Required(i));
+			else
+				bComplete = FALSE;
+		}
+	}
+
+	TMap<UClass*, INT> Levels;
+	TArray<FClassDefaultsOrder> Sorted;
+	for ( INT i=0; i<AllClasses.Num(); i++ )
+	{
+		if ( Dependencies.Find(AllClasses(i)) )
+		{
+			FClassDefaultsOrder* Entry = new(Sorted) FClassDefaultsOrder;
+			Entry->Class = AllClasses(i);
+			Entry->Index = i;
+		}
+	}
+	UBOOL bCycle = FALSE;
+	for ( INT i=0; i<Sorted.Num(); i++ )
+		Sorted(i).Level = GetClassDefaultsLevel(Sorted(i).Class, Dependencies, Levels, bCycle);
+	if ( Sorted.Num() )
+		appQsort( &Sorted(0), Sorted.Num(), sizeof(FClassDefaultsOrder), (QSORT_COMPARE)ClassDefaultsOrderCompare );
+
+	Order.Empty(Sorted.Num());
+	for ( INT i=0; i<Sorted.Num(); i++ )
+		Order.AddItem(Sorted(i).Class);
+	return bComplete && !bCycle;
+	unguard;
+}
+
 /**
  * Hierarchically import defaultproperties for all classes (Step 2).  Ensures that the class's defaults have been initialized
  * (all defaults are propagated from its parent class), propagates defaults for all struct properties, and that the class's component map is valid.
@@ -13801,13 +14857,18 @@ UBOOL FScriptCompiler::CompileDefaultProperties( const TArray<UClass*>& AllClass
 {
 	UBOOL bSuccess = TRUE;
 
+	TArray<UClass*> Order;
+	const UBOOL bComplete = GetClassDefaultsOrder( AllClasses, Order );
+
 	InDefaultPropContext = 1; // error reporting
-	for (INT i = 0; i < AllClasses.Num(); ++i)
+	GEditor->bDefaultsScheduled = bComplete;
+	for (INT i = 0; i < Order.Num(); ++i)
 	{
-		GWarn->Logf(NAME_Title, TEXT("Importing class defaults (%i/%i)"), (i + 1), AllClasses.Num());
-		if (!GEditor->ImportDefaultProps(AllClasses(i)))
+		GWarn->Logf(NAME_Title, TEXT("Importing class defaults (%i/%i)"), (i + 1), Order.Num());
+		if (!GEditor->ImportDefaultProps(Order(i)))
 			bSuccess = FALSE;
 	}
+	GEditor->bDefaultsScheduled = FALSE;
 	InDefaultPropContext = 0;
 
 	// Success.
@@ -13987,10 +15048,11 @@ UBOOL UEditor::MakeScripts(FFeedbackContext* Warn, UPackage* MyPackage, TArray<U
 			if (!Compiler.CompileScript(AllClasses, AllClasses(i), &GMem, 1, PASS_PreProcessStructs))
 				Success = FALSE;
 		}
-		for (i = 0; i < AllClasses.Num(); ++i)
+		FClassDependencyGraph Graph(AllClasses);
+		for (i = 0; i < Graph.ParseOrder.Num(); ++i)
 		{
-			GWarn->Logf(NAME_Title, TEXT("Parsing (%i/%i %ls)"), (i + 1), AllClasses.Num(), AllClasses(i)->GetName());
-			if (!ParseScripts(AllClasses(i), AllClasses, Compiler))
+			GWarn->Logf(NAME_Title, TEXT("Parsing (%i/%i %ls)"), (i + 1), Graph.ParseOrder.Num(), Graph.ParseOrder(i)->GetName());
+			if (!ParseScripts(Graph.ParseOrder(i), AllClasses, Graph, Compiler))
 				Success = FALSE;
 		}
 	}
@@ -14006,12 +15068,26 @@ UBOOL UEditor::MakeScripts(FFeedbackContext* Warn, UPackage* MyPackage, TArray<U
 	
 	if (Success)
 	{
+		// The second pass stays on this one compiler: it creates names and objects, shares GMem and the
+		// static lexer buffers, and reuses the tokens and field tables the earlier passes built up.
 		for (i = 0; i < AllClasses.Num(); ++i)
 		{
 			GWarn->Logf(NAME_Title, TEXT("Compiling (%i/%i %ls)"), (i + 1), AllClasses.Num(), AllClasses(i)->GetName());
 			if (!CompileScripts(AllClasses, Compiler, AllClasses(i)))
 				Success = FALSE;
 		}
+		if ( Success && GEditor->bOptimizeBytecode )
+		{
+			INT NumOptimized = 0;
+			for (i = 0; i < AllClasses.Num(); ++i)
+			{
+				if (AllClasses(i)->ScriptText)
+					NumOptimized += OptimizeStructCode(AllClasses(i));
+			}
+			debugf(TEXT("Bytecode optimizer rewrote %i statements"), NumOptimized);
+		}
+		if ( Success && GEditor->bPerfLint )
+			Compiler.ReportPerfLint(MyPackage);
 		if ( Success )
 		{
 			// Need to do this after CompileScripts.
@@ -14023,6 +15099,7 @@ UBOOL UEditor::MakeScripts(FFeedbackContext* Warn, UPackage* MyPackage, TArray<U
 			try
 			{
 				GWarn->Log(NAME_Title, TEXT("Importing struct defaults"));
+				ResetDefaultsFieldIndex();
 				Success = CompileStructDefaults( ScriptStructs, Compiler );
 				Success = Success && Compiler.CompileClassDefaults( AllClasses );
 			}
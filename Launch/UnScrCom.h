@@ -374,6 +374,104 @@ enum EScriptCompilerWarningLevel
 FString GetErrorLevelText( EScriptCompilerErrorLevel ErrorLevel );
 FString GetWarningLevelText( EScriptCompilerWarningLevel WarningLevel );
 
+//
+// A plain identifier or symbol exactly as the lexer produced it, before any
+// const interpretation, along with the input state the lexer left behind.
+//
+struct FLexedToken
+{
+	ETokenType	TokenType;
+	FName		TokenName;
+	FString		Identifier;
+	INT			StartPos, StartLine;
+	INT			EndPos, EndLine;
+	INT			PrevPos, PrevLine;
+};
+
+//
+// All tokens lexed so far from one class's script text, keyed by the input
+// position lexing started at.  Shared by every compiler pass over the class.
+//
+struct FLexedTokenCache
+{
+	const TCHAR*			Input;
+	INT						InputLen;
+	TMap<INT,FLexedToken>	Tokens;
+
+	FLexedTokenCache()
+	: Input(NULL)
+	, InputLen(0)
+	{}
+};
+
+//
+// Name to field lookup for the fields declared directly in one struct.
+//
+struct FFieldNameTable
+{
+	UField*				Children;	// Struct's Children when the table was built.
+	TMap<FName,UField*>	Fields;
+
+	FFieldNameTable()
+	: Children(NULL)
+	{}
+};
+
+//
+// Operator functions visible from a nest chain, as gathered by CompileExpr.
+//
+struct FOperatorLookupKey
+{
+	UStruct*	Scope;		// Innermost nest node.
+	FName		Operator;
+	DWORD		FunctionFlags;	// FUNC_Operator, plus FUNC_PreOperator for prefix operators.
+
+	FOperatorLookupKey()
+	{}
+	FOperatorLookupKey( UStruct* InScope, FName InOperator, DWORD InFunctionFlags )
+	:	Scope( InScope ), Operator( InOperator ), FunctionFlags( InFunctionFlags )
+	{}
+	UBOOL operator==( const FOperatorLookupKey& Other ) const
+	{
+		return Scope==Other.Scope && Operator==Other.Operator && FunctionFlags==Other.FunctionFlags;
+	}
+	friend DWORD GetTypeHash( const FOperatorLookupKey& Key )
+	{
+		return GetTypeHash(Key.Scope) + 7*Key.Operator.GetIndex() + 31*Key.FunctionFlags;
+	}
+};
+
+struct FOperatorCandidates
+{
+	TArray<UStruct*>	Scopes;				// Nest nodes searched, innermost first.
+	TArray<UFunction*>	Functions;			// Matching operators in search order.
+	INT					Precedence;			// Precedence of the last match.
+	INT					NumParms;			// Fewest parameters of any match, at most 3.
+	UBOOL				bAffectorOperation;	// Some match takes its first parameter by reference.
+};
+
+//
+// Code sites recorded for the performance linter.
+//
+enum EPerfLintKind
+{
+	PERFLINT_Call,				// Plain call, only used to walk the call graph.
+	PERFLINT_ActorIterator,		// foreach over AllActors or DynamicActors.
+	PERFLINT_Iterator,			// foreach over any other iterator function.
+	PERFLINT_Spawn,
+	PERFLINT_StringBuild,		// String concatenation operator.
+	PERFLINT_ArrayFind,			// Dynamic array Find.
+};
+
+struct FPerfLintSite
+{
+	UStruct*	Caller;		// Function or state whose code holds the site.
+	UFunction*	Callee;		// NULL for array Find.
+	INT			Line;
+	BYTE		Kind;		// EPerfLintKind.
+	BYTE		LoopDepth;	// Number of loops around the site.
+};
+
 //
 // Script compiler class.
 //
@@ -429,6 +527,23 @@ public:
 	/** Script writer. */
 	FScriptWriter			Writer;
 
+	/** Tokens already lexed from each class, so later passes and backtracking don't lex the same text again. */
+	TMap<UClass*,FLexedTokenCache*>	LexedTokens;
+	FLexedTokenCache*				CurrentLexedTokens;
+
+	/** Per-struct field lookup used by FindField, chained through the super structs. */
+	TMap<UStruct*,FFieldNameTable*>	FieldNameTables;
+
+	/** Operator overloads per nest chain; flushed whenever an operator is declared. */
+	TMap<FOperatorLookupKey,FOperatorCandidates>	OperatorCandidates;
+
+	/** Every loaded function by friendly name, and the memoized result of CanDevirtualize. */
+	TMultiMap<FName,UFunction*>	FunctionsByName;
+	TMap<UFunction*,UBOOL>		DevirtualizedFunctions;
+
+	/** Sites recorded during PASS_Compile when the performance linter is enabled. */
+	TArray<FPerfLintSite>	PerfLintSites;
+
 	// Constructor.
 	FScriptCompiler( FFeedbackContext* InWarn, UBOOL bParseOnly )
 	: Writer( *this )
@@ -442,6 +557,7 @@ public:
 	, RequiredWarningLevel(SCWL_Level1)
 	, OriginalVariableIndex(0)
 	, HookHack(NULL)
+	, CurrentLexedTokens(NULL)
 	{
 		FScriptLocation::Compiler = this;
 	}
@@ -452,6 +568,14 @@ public:
 		{
 			FScriptLocation::Compiler = NULL;
 		}
+		for( TMap<UClass*,FLexedTokenCache*>::TIterator It(LexedTokens); It; ++It )
+		{
+			delete It.Value();
+		}
+		for( TMap<UStruct*,FFieldNameTable*>::TIterator It(FieldNameTables); It; ++It )
+		{
+			delete It.Value();
+		}
 	}
 
 	// Precomputation.
@@ -561,6 +685,12 @@ public:
 	 * @return	a pointer to a UField with a name matching InIdentifier, or NULL if it wasn't found
 	 */
 	UField*			FindField( UStruct* InScope, const TCHAR* InIdentifier, UBOOL bIncludeParents=TRUE, UClass* FieldClass=UField::StaticClass(), const TCHAR* Thing=NULL, INT* OuterContextCount=NULL );
+	UField*			FindScopeField( UStruct* Struct, FName InName, UBOOL bIncludeParents );
+	const FOperatorCandidates& GetOperatorCandidates( FName Operator, DWORD FunctionFlags );
+	void			InvalidateFieldNames( UStruct* Struct );
+	UBOOL			CanDevirtualize( UFunction* Function );
+	void			RecordPerfLintSite( BYTE Kind, UFunction* Callee );
+	void			ReportPerfLint( UPackage* Package );
 	INT				ConversionCost( const FPropertyBase& Dest, const FPropertyBase& Source );
 	void			SkipStatements( int SubCount, const TCHAR* ErrorTag );
 	/**
@@ -663,6 +793,8 @@ public:
 
 	// Low-level parsing functions.
 	const TCHAR*	NestTypeName( ENestType NestType );
+	UBOOL			GetLexedToken( FToken& Token, INT LexPos, UBOOL NoConsts );
+	void			StoreLexedToken( const FToken& Token, INT LexPos, UBOOL NoConsts );
 	TCHAR			GetChar( UBOOL Literal=0 );
 	TCHAR			PeekChar();
 	TCHAR			GetLeadingChar();
@@ -726,6 +858,7 @@ public:
 
 	// Emitters.
 	void			EmitConstant( FToken& ConstToken );
+	UBOOL			FoldConstantOperator( UFunction* Operator, UBOOL IsPreOperator, FToken& Left, FToken& Right, FScriptLocation& StartOfExpression, FScriptLocation& MidRetry, FToken& Result );
 	void			EmitStackNodeLinkFunction( UFunction* Node, UBOOL ForceFinal, UBOOL Global, UProperty *DelegateProp = NULL );
 	
 	/**
@@ -775,17 +908,6 @@ public:
 	void ScriptErrorf(EScriptCompilerErrorLevel ErrorLevel, const TCHAR* Msg, ...);
 	void ScriptWarnf(EScriptCompilerWarningLevel WarningLevel, const TCHAR* Msg, ...);
 
-	/**
-	 * Helper function to determine whether the class hierarchy rooted at Suspect is
-	 * dependent on the hierarchy rooted at Source.
-	 *
-	 * @param	Suspect		Root of hierarchy for suspect class
-	 * @param	Source		Root of hierarchy for source class
-	 * @param	AllClasses	Array of parsed classes
-	 * @return	TRUE if the hierarchy rooted at Suspect is dependent on the one rooted at Source, FALSE otherwise
-	 */
-	UBOOL IsDependentOn( UClass* Suspect, UClass* Source, const TArray<UClass*>& AllClasses );
-
 	/**
 	 * Hierarchically import defaultproperties for all classes (Step 2).  Ensures that the class's defaults have been initialized
 	 * (all defaults are propagated from its parent class), propagates defaults for all struct properties, and that the class's component map is valid.
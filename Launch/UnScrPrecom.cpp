@@ -126,7 +126,7 @@ void FCommentStrippingFilter::Process(const TCHAR* Begin, const TCHAR* End, FStr
 *
 */
 FMacroProcessingFilter::FMacroProcessingFilter(const TCHAR * pName, const FString & fileName, FFeedbackContext* inWarn) 
-:  FTextFilter(fileName, inWarn), PackageName(pName), NestLevel_If(0)
+:  FTextFilter(fileName, inWarn), PackageName(pName), NestLevel_If(0), bVolatileOutput(FALSE)
 {
 	guard(FMacroProcessingFilter::FMacroProcessingFilter);
 	bIsShippingPackage = 0;
@@ -143,6 +143,7 @@ FMacroProcessingFilter::FMacroProcessingFilter(const TCHAR * pName, const FStrin
 }
 
 TMap<FName,FScriptMacroDefinition>* FMacroProcessingFilter::GlobalSymbols=NULL;
+TMap<FIfConditionKey,UBOOL> FMacroProcessingFilter::IfConditionResults;
 UBOOL FMacroProcessingFilter::bInitializingGlobalSymbols=FALSE;
 
 /**
@@ -242,6 +243,10 @@ void FMacroProcessingFilter::InitSymbolTable()
 		FString UnusedResult;
 		Process(*GlobalUCIContents, *GlobalUCIContents + GlobalUCIContents.Len(), UnusedResult);
 		bInitializingGlobalSymbols = FALSE;
+
+		// the globals are covered by the preprocess cache key, only the class itself should be tracked
+		IncludedFiles.Empty();
+		bVolatileOutput = FALSE;
 	}
 	unguard;
 }
@@ -294,6 +299,32 @@ void FMacroProcessingFilter::InitSymbolTable()
  * @param	End		pointer to the end of the source file's text
  * @param	Result	[out] buffer that will contain the post processed text
  */
+/** Characters FMacroProcessingFilter::Process has to look at; everything else is copied to the output as is. */
+static UBOOL IsMacroFilterStopChar( TCHAR ch )
+{
+	return ch == FMacroProcessingFilter::CALL_MACRO_CHAR || ch == TEXT('"') || ch == TEXT('\\')
+		|| ch == TEXT('/') || ch == TEXT('*') || ch == TEXT('\n') || ch == 0;
+}
+
+/**
+ * Characters that matter inside a disabled `if block: macros that may end it, the quote state, and
+ * line breaks, which GetSpan must not consume or the provider loses count of the line.
+ */
+static UBOOL IsSkippedBlockStopChar( TCHAR ch )
+{
+	return ch == FMacroProcessingFilter::CALL_MACRO_CHAR || ch == TEXT('"') || ch == TEXT('\\') || ch == TEXT('\n') || ch == 0;
+}
+
+/** Appends Count characters from Chars to Result. */
+static void AppendChars( FString& Result, const TCHAR* Chars, INT Count )
+{
+	TArray<TCHAR>& ResultChars = Result.GetCharArray();
+	const INT Index = ResultChars.Num() ? ResultChars.Num() - 1 : 0;
+	ResultChars.Add(Count + (ResultChars.Num() ? 0 : 1));
+	appMemcpy(&ResultChars(Index), Chars, Count * sizeof(TCHAR));
+	ResultChars(Index + Count) = 0;
+}
+
 void FMacroProcessingFilter::Process( const TCHAR* Begin, const TCHAR* End, FString& Result )
 {
 	guard(FMacroProcessingFilter::Process);
@@ -321,6 +352,36 @@ void FMacroProcessingFilter::Process( const TCHAR* Begin, const TCHAR* End, FStr
 
 	while (SourceBuffer) 
 	{
+		if ( IsOutputEnabled() )
+		{
+			// none of the special handling below applies to these, whatever state we're in
+			const TCHAR* Span;
+			const INT SpanLength = SourceBuffer.GetSpan(Span, IsMacroFilterStopChar);
+			if ( SpanLength )
+			{
+				Unemitted.Empty();
+				AppendChars(Result, Span, SpanLength);
+				continue;
+			}
+		}
+		else
+		{
+			// skipped text only keeps its line breaks, so jump straight to the next macro, quote or '\n'
+			const TCHAR* Span;
+			const INT SpanLength = SourceBuffer.GetSpan(Span, IsSkippedBlockStopChar);
+			if ( SpanLength )
+			{
+				for ( INT i = 0; i < SpanLength; i++ )
+				{
+					if ( Span[i] == TEXT('\r') )
+					{
+						Result += Span[i];
+					}
+				}
+				continue;
+			}
+		}
+
 		ch = SourceBuffer.GetChar();
 		if ( ch == 0 )
 			continue;
@@ -792,6 +853,258 @@ INT FMacroProcessingFilter::GetParamList(TArray<FString> & Params)
 
 }
 
+/** Reads a macro name the way ParseMacroName does, returning the index just past it (and any whitespace it eats). */
+static INT ParseSegmentName( const FString& Text, INT Pos, FString& Name )
+{
+	const UBOOL bWrapped = Text[Pos] == FMacroProcessingFilter::BEGIN_MACRO_BLOCK_CHAR;
+	if ( bWrapped )
+	{
+		Pos++;
+	}
+	const INT NameStart = Pos;
+	while ( Pos < Text.Len() && (appIsAlnum(Text[Pos]) || Text[Pos] == TEXT('_')) )
+	{
+		Pos++;
+	}
+	Name = Text.Mid(NameStart, Pos - NameStart);
+	if ( bWrapped )
+	{
+		if ( Pos >= Text.Len() || Text[Pos] != FMacroProcessingFilter::END_MACRO_BLOCK_CHAR )
+		{
+			return INDEX_NONE;
+		}
+		return Pos + 1;
+	}
+	if ( Pos < Text.Len() && (Text[Pos] == FMacroProcessingFilter::MACRO_PARAMCOUNT_CHAR || Text[Pos] == FMacroProcessingFilter::CALL_MACRO_CHAR) )
+	{
+		return INDEX_NONE;
+	}
+	while ( Pos < Text.Len() && appIsWhitespace(Text[Pos]) )
+	{
+		Pos++;
+	}
+	return Pos;
+}
+
+UBOOL FScriptMacroDefinition::Compile()
+{
+	if ( CompileState != MACROCOMPILE_None )
+	{
+		return CompileState == MACROCOMPILE_Compiled;
+	}
+	CompileState = MACROCOMPILE_Failed;
+	Segments.Empty();
+
+	const FString& Text = MacroDefinition;
+	TArray<UBOOL> HasElse;
+	INT LiteralStart = 0;
+	INT Pos = 0;
+	while ( Pos < Text.Len() )
+	{
+		if ( Text[Pos] != FMacroProcessingFilter::CALL_MACRO_CHAR )
+		{
+			Pos++;
+			continue;
+		}
+		if ( Pos > 0 && Text[Pos - 1] == TEXT('\\') )
+		{
+			// may be an escaped macro char inside a string
+			return FALSE;
+		}
+		if ( Pos > LiteralStart )
+		{
+			FMacroSegment* Literal = new(Segments) FMacroSegment;
+			Literal->Type = MACROSEG_Literal;
+			Literal->Start = LiteralStart;
+			Literal->Len = Pos - LiteralStart;
+		}
+
+		FString Name;
+		Pos = Pos + 1 < Text.Len() ? ParseSegmentName(Text, Pos + 1, Name) : INDEX_NONE;
+		if ( Pos == INDEX_NONE || Name.Len() == 0 )
+		{
+			return FALSE;
+		}
+		const UBOOL bParams = Pos < Text.Len() && Text[Pos] == TEXT('(');
+		const FName SegmentName(*Name);
+
+		FMacroSegment Segment;
+		Segment.Param = INDEX_NONE;
+		if ( SegmentName == NAME_If )
+		{
+			// only `if(`param), which is all the logging macros use
+			if ( !bParams )
+			{
+				return FALSE;
+			}
+			Pos++;
+			while ( Pos < Text.Len() && appIsWhitespace(Text[Pos]) )
+			{
+				Pos++;
+			}
+			if ( Pos + 1 >= Text.Len() || Text[Pos] != FMacroProcessingFilter::CALL_MACRO_CHAR )
+			{
+				return FALSE;
+			}
+			Pos = ParseSegmentName(Text, Pos + 1, Name);
+			while ( Pos != INDEX_NONE && Pos < Text.Len() && appIsWhitespace(Text[Pos]) )
+			{
+				Pos++;
+			}
+			if ( Pos == INDEX_NONE || Pos >= Text.Len() || Text[Pos] != TEXT(')') || Name.Len() == 0 )
+			{
+				return FALSE;
+			}
+			Pos++;
+			Segment.Type = MACROSEG_If;
+			for ( INT i = MacroParameterNames.Num() - 1; i >= 0 && Segment.Param == INDEX_NONE; i-- )
+			{
+				if ( FName(*MacroParameterNames(i)) == FName(*Name) )
+				{
+					Segment.Param = MacroParameterNames.Num() - 1 - i;
+				}
+			}
+			if ( Segment.Param == INDEX_NONE || HasElse.Num() >= 32 )
+			{
+				return FALSE;
+			}
+			HasElse.AddItem(FALSE);
+		}
+		else if ( bParams )
+		{
+			return FALSE;
+		}
+		else if ( SegmentName == NAME_Else )
+		{
+			if ( HasElse.Num() == 0 || HasElse.Top() )
+			{
+				return FALSE;
+			}
+			HasElse.Top() = TRUE;
+			Segment.Type = MACROSEG_Else;
+		}
+		else if ( SegmentName == NAME_EndIf )
+		{
+			if ( HasElse.Num() == 0 )
+			{
+				return FALSE;
+			}
+			HasElse.Pop();
+			Segment.Type = MACROSEG_EndIf;
+		}
+		else
+		{
+			Segment.Type = MACROSEG_Param;
+			for ( INT i = MacroParameterNames.Num() - 1; i >= 0 && Segment.Param == INDEX_NONE; i-- )
+			{
+				if ( FName(*MacroParameterNames(i)) == SegmentName )
+				{
+					Segment.Param = MacroParameterNames.Num() - 1 - i;
+				}
+			}
+			if ( Segment.Param == INDEX_NONE )
+			{
+				return FALSE;
+			}
+		}
+		Segments.AddItem(Segment);
+		LiteralStart = Pos;
+	}
+	if ( HasElse.Num() )
+	{
+		return FALSE;
+	}
+	if ( Pos > LiteralStart )
+	{
+		FMacroSegment* Literal = new(Segments) FMacroSegment;
+		Literal->Type = MACROSEG_Literal;
+		Literal->Start = LiteralStart;
+		Literal->Len = Pos - LiteralStart;
+	}
+	CompileState = MACROCOMPILE_Compiled;
+	return TRUE;
+}
+
+UBOOL FMacroProcessingFilter::ExpandCompiledMacro( const FName& macroName, FScriptMacroDefinition& definition, const TArray<FString>& parameters )
+{
+	guard(FMacroProcessingFilter::ExpandCompiledMacro);
+	if ( !definition.Compile() )
+	{
+		return FALSE;
+	}
+	for ( INT i = 0; i < parameters.Num(); i++ )
+	{
+		if ( parameters(i).InStr(FString::Chr(CALL_MACRO_CHAR)) != INDEX_NONE )
+		{
+			return FALSE;
+		}
+	}
+
+	// mirrors EnableOutputFlag for the `if blocks of this definition
+	const INT LastParam = definition.GetParameterNames().Num() - 1;
+	UBOOL IfFlags[32];
+	INT IfDepth = 0;
+	INT NumDisabled = 0;
+	FString Expanded;
+	const TCHAR* Text = *definition.MacroDefinition;
+	for ( INT i = 0; i < definition.Segments.Num(); i++ )
+	{
+		const FMacroSegment& Segment = definition.Segments(i);
+		switch ( Segment.Type )
+		{
+		case MACROSEG_Literal:
+			if ( NumDisabled == 0 )
+			{
+				AppendChars(Expanded, Text + Segment.Start, Segment.Len);
+			}
+			else
+			{
+				// Process() still emits line breaks from disabled text, and still tracks its quotes
+				for ( INT j = Segment.Start; j < Segment.Start + Segment.Len; j++ )
+				{
+					if ( Text[j] == TEXT('"') || Text[j] == TEXT('\\') )
+					{
+						return FALSE;
+					}
+					if ( Text[j] == TEXT('\r') || Text[j] == TEXT('\n') )
+					{
+						Expanded += Text[j];
+					}
+				}
+			}
+			break;
+		case MACROSEG_Param:
+			if ( NumDisabled == 0 && parameters.IsValidIndex(LastParam - Segment.Param) )
+			{
+				Expanded += parameters(LastParam - Segment.Param);
+			}
+			break;
+		case MACROSEG_If:
+			{
+				UBOOL bOutputEnabled = FALSE;
+				if ( NumDisabled == 0 && parameters.IsValidIndex(LastParam - Segment.Param) )
+				{
+					const FString& valueString = parameters(LastParam - Segment.Param);
+					bOutputEnabled = valueString.Len() > 0 && valueString != TEXT("FALSE") && valueString != GFalse && valueString != TEXT("0");
+				}
+				IfFlags[IfDepth++] = bOutputEnabled;
+				NumDisabled += !bOutputEnabled;
+			}
+			break;
+		case MACROSEG_Else:
+			NumDisabled += IfFlags[IfDepth - 1] ? 1 : -1;
+			IfFlags[IfDepth - 1] = !IfFlags[IfDepth - 1];
+			break;
+		case MACROSEG_EndIf:
+			NumDisabled -= !IfFlags[--IfDepth];
+			break;
+		}
+	}
+	SourceBuffer.AddExpandedMacro(Expanded, macroName);
+	return TRUE;
+	unguard;
+}
+
 /**
  * Replaces a macro with the expanded definition for that macro.
  * 
@@ -858,8 +1171,11 @@ void FMacroProcessingFilter::ExpandMacro(const FName& macroName)
 
 			if (NestLevel_If >= 1)
 			{
+				// after macro expansion the condition is made of literals only, so its value never changes
+				const FIfConditionKey Key(parameters(0));
+				const UBOOL* CachedResult = IfConditionResults.Find(Key);
 				const TCHAR* Condition = *parameters(0);
-				const UBOOL bOutputEnabled = EvaluteIfCondition((TCHAR*)Condition);
+				const UBOOL bOutputEnabled = CachedResult ? *CachedResult : IfConditionResults.Set(Key, EvaluteIfCondition((TCHAR*)Condition));
 
 				EnableOutputFlag.AddItem(bOutputEnabled);
 			}
@@ -1154,10 +1470,13 @@ void FMacroProcessingFilter::ExpandMacro(const FName& macroName)
 		if (SourceBuffer.PeekChar() == '(') 
 		{
 			GetParamList(parameters);
-			FString& value = definition->MacroDefinition;
-			SourceBuffer.AddMacro(*value, *value + value.Len(), macroName, definition, &parameters);
+			if ( !ExpandCompiledMacro(macroName, *definition, parameters) )
+			{
+				FString& value = definition->MacroDefinition;
+				SourceBuffer.AddMacro(*value, *value + value.Len(), macroName, definition, &parameters);
+			}
 		}
-		else 
+		else if ( !ExpandCompiledMacro(macroName, *definition, parameters) )
 		{
 			// this macro has no parameters - in order for it to be correctly evaluated,
 			// it needs to have the definition of the macro as its only parameter
@@ -1200,21 +1519,68 @@ UBOOL FMacroProcessingFilter::ShouldProcessMacro(const FName& macroName)
 }
 
 /**
- * Parses the specified file and adds it to the stack of character providers.
- *
- * @param	IncludeFilename		the name of the file to process (i.e. Core\Globals.uci)
- * @param	FileContent			receives a pointer to the processed version of the file.
+ * Include files read during this run, kept comment-stripped so that every class including the same
+ * .uci only pays for the read and the comment pass once.  An entry is reused while the file keeps its
+ * size and write time.  Texts are never freed during the run, since the character providers read
+ * them in place.  Also holds the index of .uci files found under EditPackagesInPath, which
+ * includes fall back to when the package relative path doesn't exist.
  */
-void FMacroProcessingFilter::ProcessIncludeFile( const TCHAR* OriginalFilename, FString* FileContent/*=NULL*/ )
+class FIncludeFileCache
 {
-	guard(FMacroProcessingFilter::ProcessIncludeFile);
-	FString fileName = OriginalFilename;
-	FString fileContent;
-	UBOOL bSuccess = appLoadFileToString(fileContent, *fileName);
-	if (!bSuccess && !bInitializingGlobalSymbols)
+public:
+	FIncludeFileCache()
+	: ModUciFiles(NULL)
+	{}
+
+	~FIncludeFileCache()
+	{
+		for( INT i=0; i<Texts.Num(); i++ )
+			delete Texts(i);
+		delete ModUciFiles;
+	}
+
+	/**
+	 * @return	the comment-stripped contents of Filename, or NULL if it can't be read
+	 */
+	const FString* Load( const FString& Filename, FFeedbackContext* Warn )
+	{
+		guard(FIncludeFileCache::Load);
+		const INT Size = GFileManager->FileSize(*Filename);
+		if( Size==INDEX_NONE )
+		{
+			return NULL;
+		}
+		const SQWORD Time = GFileManager->GetGlobalTime(*Filename);
+		FCachedFile* Cached = Files.Find(Filename);
+		if( Cached && Cached->Size==Size && Cached->Time==Time )
+		{
+			return Cached->Stripped;
+		}
+
+		FString FileContent;
+		if( !appLoadFileToString(FileContent, *Filename) )
+		{
+			return NULL;
+		}
+		FCachedFile NewFile;
+		NewFile.Size = Size;
+		NewFile.Time = Time;
+		NewFile.Stripped = new FString;
+		Texts.AddItem(NewFile.Stripped);
+		FCommentStrippingFilter Stripper(Filename, Warn);
+		Stripper.Process(*FileContent, *FileContent + FileContent.Len(), *NewFile.Stripped);
+		Files.Set(Filename, NewFile);
+		return NewFile.Stripped;
+		unguard;
+	}
+
+	/**
+	 * @return	the path of a .uci file named IncludeName (without extension) in any folder under
+	 *			EditPackagesInPath, or NULL if there's none
+	 */
+	const FString* FindModUci( const FString& IncludeName )
 	{
-		static TMap<FString, FString>* ModUciFiles = NULL;
-		if (!ModUciFiles)
+		if( !ModUciFiles )
 		{
 			guard(CacheGlobalUci);
 			ModUciFiles = new TMap<FString, FString>;
@@ -1241,28 +1607,58 @@ void FMacroProcessingFilter::ProcessIncludeFile( const TCHAR* OriginalFilename,
 			}
 			unguard;
 		}
-		FString* Result = ModUciFiles->Find(*fileName.GetFilenameOnly());
+		return ModUciFiles->Find(IncludeName);
+	}
+
+private:
+	struct FCachedFile
+	{
+		INT		Size;
+		SQWORD	Time;
+		FString* Stripped;
+	};
+	TMap<FString, FCachedFile> Files;
+	TArray<FString*> Texts;
+	TMap<FString, FString>* ModUciFiles;
+};
+static FIncludeFileCache GIncludeFileCache;
+
+/**
+ * Parses the specified file and adds it to the stack of character providers.
+ *
+ * @param	IncludeFilename		the name of the file to process (i.e. Core\Globals.uci)
+ * @param	FileContent			receives a pointer to the processed version of the file.
+ */
+void FMacroProcessingFilter::ProcessIncludeFile( const TCHAR* OriginalFilename, FString* FileContent/*=NULL*/ )
+{
+	guard(FMacroProcessingFilter::ProcessIncludeFile);
+	FString fileName = OriginalFilename;
+	const FString* strippedFileContent = GIncludeFileCache.Load(fileName, Warn);
+	if (!bInitializingGlobalSymbols)
+	{
+		// record misses too, creating the file later changes what this include resolves to
+		IncludedFiles.AddUniqueItem(fileName);
+	}
+	if (!strippedFileContent && !bInitializingGlobalSymbols)
+	{
+		const FString* Result = GIncludeFileCache.FindModUci(fileName.GetFilenameOnly());
 		if (Result)
 		{
 			fileName = *Result;
-			bSuccess = appLoadFileToString(fileContent, *fileName);
+			strippedFileContent = GIncludeFileCache.Load(fileName, Warn);
+			IncludedFiles.AddUniqueItem(fileName);
 		}
 	}
 
-	if (bSuccess)
+	if (strippedFileContent)
 	{
-		// run the comment stripper on the newly included file
-		FCommentStrippingFilter stripper(fileName, Warn);
-		FString strippedFileContent;
-		stripper.Process(*fileContent, *fileContent + fileContent.Len(), strippedFileContent);
-
 		if ( bInitializingGlobalSymbols && FileContent != NULL )
 		{
-			*FileContent = strippedFileContent;
+			*FileContent = *strippedFileContent;
 		}
 		else
 		{
-			SourceBuffer.AddFile(*strippedFileContent, *strippedFileContent + strippedFileContent.Len(), fileName);
+			SourceBuffer.AddFile(**strippedFileContent, **strippedFileContent + strippedFileContent->Len(), fileName);
 		}
 	}
 	else 
@@ -1276,6 +1672,116 @@ void FMacroProcessingFilter::ProcessIncludeFile( const TCHAR* OriginalFilename,
 	unguard;
 }
 
+UBOOL FMacroProcessingFilter::IsVolatileSymbol( const FName& macroName )
+{
+	static FName DateName(TEXT("Date")), TimeName(TEXT("Time"));
+	return macroName==DateName || macroName==TimeName;
+}
+
+#define PREPROCESS_CACHE_TAG		0x31435050 /* PPC1 */
+#define PREPROCESS_CACHE_VERSION	2
+
+static void HashString( FMD5Context& Context, const TCHAR* Str )
+{
+	appMD5Update( &Context, (BYTE*)Str, (appStrlen(Str) + 1) * sizeof(TCHAR) );
+}
+
+UBOOL FMacroProcessingFilter::LoadCachedResult( const TCHAR* Begin, const TCHAR* End, FString& Result )
+{
+	guard(FMacroProcessingFilter::LoadCachedResult);
+	if( !GEditor->PreprocessCachePath.Len() )
+		return 0;
+
+	// Hash everything the output depends on, except for the include files which are only known after processing.
+	FMD5Context Context;
+	appMD5Init( &Context );
+	INT Version = PREPROCESS_CACHE_VERSION;
+	appMD5Update( &Context, (BYTE*)&Version, sizeof(Version) );
+	appMD5Update( &Context, (BYTE*)Begin, (End - Begin) * sizeof(TCHAR) );
+	HashString( Context, *GEditor->EditPackagesInPath );
+	HashString( Context, *PackageName );
+	HashString( Context, *ClassName );
+	check(GlobalSymbols);
+	for( TMap<FName,FScriptMacroDefinition>::TIterator It(*GlobalSymbols); It; ++It )
+	{
+		HashString( Context, *It.Key() );
+		if( IsVolatileSymbol(It.Key()) )
+			continue;
+		const TArray<FString>& Params = It.Value().GetParameterNames();
+		for( INT i=0; i<Params.Num(); i++ )
+			HashString( Context, *Params(i) );
+		HashString( Context, *It.Value().MacroDefinition );
+	}
+	appMD5Final( CacheDigest, &Context );
+	CacheFilename = FString::Printf(TEXT("%ls") PATH_SEPARATOR TEXT("%ls_%ls.ppc"), *GEditor->PreprocessCachePath, *PackageName, *ClassName);
+
+	FArchive* CacheFile = GFileManager->CreateFileReader( *CacheFilename );
+	if( !CacheFile )
+		return 0;
+	INT Tag=0, IncludeCount=0;
+	BYTE Digest[16];
+	FString CachedResult;
+	UBOOL bValid = 0;
+	Version = 0;
+	*CacheFile << Tag << Version;
+	if( Tag==PREPROCESS_CACHE_TAG && Version==PREPROCESS_CACHE_VERSION )
+	{
+		CacheFile->Serialize( Digest, sizeof(Digest) );
+		if( !CacheFile->IsError() && appMemcmp(Digest, CacheDigest, sizeof(Digest))==0 )
+		{
+			*CacheFile << CachedResult << IncludeCount;
+			bValid = !CacheFile->IsError() && IncludeCount>=0;
+			for( INT i=0; i<IncludeCount && bValid; i++ )
+			{
+				FString Filename;
+				INT Size=0;
+				SQWORD Time=0;
+				*CacheFile << Filename << Size << Time;
+				bValid = !CacheFile->IsError()
+					&& GFileManager->FileSize(*Filename)==Size
+					&& GFileManager->GetGlobalTime(*Filename)==Time;
+			}
+		}
+	}
+	delete CacheFile;
+	if( !bValid )
+		return 0;
+	Result = CachedResult;
+	return 1;
+	unguard;
+}
+
+void FMacroProcessingFilter::SaveCachedResult( const FString& Result )
+{
+	guard(FMacroProcessingFilter::SaveCachedResult);
+	if( !CacheFilename.Len() || bVolatileOutput )
+		return;
+
+	GFileManager->MakeDirectory( *GEditor->PreprocessCachePath, 1 );
+	FArchive* CacheFile = GFileManager->CreateFileWriter( *CacheFilename );
+	if( !CacheFile )
+	{
+		debugf( NAME_Warning, TEXT("Failed to create preprocess cache '%ls'"), *CacheFilename );
+		return;
+	}
+	INT Tag = PREPROCESS_CACHE_TAG, Version = PREPROCESS_CACHE_VERSION, IncludeCount = IncludedFiles.Num();
+	FString ResultCopy = Result;
+	*CacheFile << Tag << Version;
+	CacheFile->Serialize( CacheDigest, sizeof(CacheDigest) );
+	*CacheFile << ResultCopy << IncludeCount;
+	for( INT i=0; i<IncludeCount; i++ )
+	{
+		INT Size = GFileManager->FileSize( *IncludedFiles(i) );
+		SQWORD Time = GFileManager->GetGlobalTime( *IncludedFiles(i) );
+		*CacheFile << IncludedFiles(i) << Size << Time;
+	}
+	UBOOL WriteOk = CacheFile->Close();
+	delete CacheFile;
+	if( !WriteOk )
+		GFileManager->Delete( *CacheFilename );
+	unguard;
+}
+
 /**
  * Parses individual values from an `ifcondition expression (e.g. "`ifcondition(true && (0 == 1))", true, 0 and 1 are values)
  *
@@ -15,6 +15,49 @@ enum EIfPropertyType
 	IPT_String
 };
 
+/**
+ * Piece of a precompiled macro definition, see FScriptMacroDefinition::Compile
+ */
+enum EMacroSegmentType
+{
+	MACROSEG_Literal,	// text copied as is
+	MACROSEG_Param,		// value of a parameter
+	MACROSEG_If,		// `if(`param)
+	MACROSEG_Else,
+	MACROSEG_EndIf,
+};
+
+/**
+ * Key for the `ifcondition memo.  String operands are compared case-sensitively, so unlike an
+ * FString key this never lets conditions that differ only in case share a result.
+ */
+struct FIfConditionKey
+{
+	FString		Condition;	// Macro-expanded condition text.
+
+	FIfConditionKey()
+	{}
+	FIfConditionKey( const FString& InCondition )
+	:	Condition( InCondition )
+	{}
+	UBOOL operator==( const FIfConditionKey& Other ) const
+	{
+		return appStrcmp(*Condition, *Other.Condition)==0;
+	}
+	friend DWORD GetTypeHash( const FIfConditionKey& Key )
+	{
+		return appStrCrc(*Key.Condition);
+	}
+};
+
+struct FMacroSegment
+{
+	BYTE	Type;		// EMacroSegmentType
+	INT		Param;		// parameter for MACROSEG_Param and MACROSEG_If, counted from the last one since AddParameterName inserts in front
+	INT		Start;		// MACROSEG_Literal range in MacroDefinition
+	INT		Len;
+};
+
 /**
  * A simple struct for tracking macro parameter names and definitions
  *
@@ -24,6 +67,17 @@ struct FScriptMacroDefinition
 	/** actual definition of the macro */
 	FString				MacroDefinition;
 
+	/** MacroDefinition as segments, valid if CompileState is MACROCOMPILE_Compiled */
+	TArray<FMacroSegment>	Segments;
+
+	enum
+	{
+		MACROCOMPILE_None,
+		MACROCOMPILE_Compiled,
+		MACROCOMPILE_Failed,	// uses something other than its own parameters and `if(`param)/`else/`endif
+	};
+	BYTE				CompileState;
+
 	/** @name FScriptMacroDefinition implementation */
 	//@{
 	const TArray<FString>& GetParameterNames() const
@@ -61,24 +115,33 @@ struct FScriptMacroDefinition
 		MacroParameterNames(Index) = NewParameter;
 		return Index;
 	}
+
+	/**
+	 * Splits MacroDefinition into literal text, parameter references and `if(`param) blocks, once.
+	 *
+	 * @return	TRUE if the definition can be expanded from its segments
+	 */
+	UBOOL Compile();
 	//@}
 
 
 	/** @name Constructors */
 	//@{
 	FScriptMacroDefinition()
+	: CompileState(MACROCOMPILE_None)
 	{ }
 
 	FScriptMacroDefinition( const TCHAR* inValue )
-	: MacroDefinition(inValue)
+	: MacroDefinition(inValue), CompileState(MACROCOMPILE_None)
 	{ }
 
 	FScriptMacroDefinition( const TArray<FString>& inParameterNames, const TCHAR* inValue )
-	: MacroParameterNames(inParameterNames), MacroDefinition(inValue)
+	: MacroParameterNames(inParameterNames), MacroDefinition(inValue), CompileState(MACROCOMPILE_None)
 	{ }
 
 	/** Copy constructor */
 	FScriptMacroDefinition( const FScriptMacroDefinition& Other )
+	: CompileState(MACROCOMPILE_None)
 	{
 		MacroParameterNames = Other.MacroParameterNames;
 		MacroDefinition = Other.MacroDefinition;
@@ -107,15 +170,17 @@ public:
 	*/
 	TCHAR PeekChar(INT Offset = 0) const 
 	{
-		INT dLen = PriorityStack.Len();
-		if (dLen > Offset)
+		for ( INT i = PushedText.Num() - 1; i >= 0; i-- )
 		{
-			return PriorityStack[dLen - (Offset + 1)];
+			const FPushedText& Pushed = PushedText(i);
+			const INT Remaining = Pushed.Text.Len() - Pushed.Pos;
+			if ( Offset < Remaining )
+			{
+				return (*Pushed.Text)[Pushed.Pos + Offset];
+			}
+			Offset -= Remaining;
 		}
-		else
-		{
-			return *BufferStart;
-	}
+		return BufferStart + Offset < BufferEnd ? BufferStart[Offset] : TCHAR('\0');
 	}
 
 	/** 
@@ -126,11 +191,14 @@ public:
 	TCHAR GetChar() 
 	{
 		TCHAR retval;
-		INT dLen = PriorityStack.Len();
-		if (dLen) 
+		while ( PushedText.Num() && PushedText.Top().Pos == PushedText.Top().Text.Len() )
 		{
-			retval = PriorityStack[dLen - 1];
-			PriorityStack = PriorityStack.Left(dLen-1);
+			PushedText.Remove(PushedText.Num() - 1);
+		}
+		if (PushedText.Num()) 
+		{
+			FPushedText& Pushed = PushedText.Top();
+			retval = (*Pushed.Text)[Pushed.Pos++];
 		}
 		else if (BufferStart != BufferEnd) 
 		{
@@ -152,6 +220,50 @@ public:
 		return retval;
 	}
 
+	/**
+	* Consumes the characters up to the next one IsStopChar accepts, as long as they are contiguous
+	* in one buffer, and returns them without copying.  Never consumes a line break, so the caller
+	* must stop on '\n'.
+	*
+	* @param	SpanStart	[out] the first character consumed
+	* @param	IsStopChar	returns TRUE for the characters the caller needs to see one by one
+	*
+	* @return	the number of characters consumed, 0 if the next one is a stop character
+	*/
+	INT GetSpan(const TCHAR*& SpanStart, UBOOL (*IsStopChar)(TCHAR))
+	{
+		const TCHAR* SpanEnd;
+		if (PushedText.Num())
+		{
+			// if the topmost pushed text is used up this returns 0, and GetChar() moves on
+			FPushedText& Pushed = PushedText.Top();
+			SpanStart = *Pushed.Text + Pushed.Pos;
+			SpanEnd = *Pushed.Text + Pushed.Text.Len();
+		}
+		else
+		{
+			SpanStart = BufferStart;
+			SpanEnd = BufferEnd;
+		}
+
+		const TCHAR* p = SpanStart;
+		while ( p < SpanEnd && !IsStopChar(*p) )
+		{
+			++p;
+		}
+		const INT Count = p - SpanStart;
+		if (PushedText.Num())
+		{
+			PushedText.Top().Pos += Count;
+		}
+		else
+		{
+			BufferStart = p;
+		}
+		InputPos += Count;
+		return Count;
+	}
+
 	/**
 	* Puts a character back into the front of the input stream
 	*
@@ -168,18 +280,38 @@ public:
 		}
 
 		--InputPos;
-		PriorityStack += ch;
+
+		// usually the character just read is put back, so only step back over it
+		if (PushedText.Num())
+		{
+			FPushedText& Pushed = PushedText.Top();
+			if ( Pushed.Pos > 0 && (*Pushed.Text)[Pushed.Pos - 1] == ch )
+			{
+				Pushed.Pos--;
+				return;
+			}
+		}
+		else if ( BufferStart > BufferBegin && BufferStart[-1] == ch )
+		{
+			BufferStart--;
+			return;
+		}
+		PushString(FString::Chr(ch));
 	}
 
 	/**
-	* push the specified string onto the PriorityStack; requires reversing the incoming
-	* string first so that the characters pop off in the right order
+	* push the specified string onto the PushedText stack, so it is read before anything else
 	*
 	* @param	str		the string to inject into the input stream
 	*/
 	void PushString(const FString& str) 
 	{
-		PriorityStack += str.Reverse();
+		if ( str.Len() )
+		{
+			FPushedText* Pushed = new(PushedText) FPushedText;
+			Pushed->Text = str;
+			Pushed->Pos = 0;
+		}
 	}
 
 	/**
@@ -189,7 +321,14 @@ public:
 	*/
 	operator UBOOL() const 
 	{
-		return (PriorityStack.Len() || (BufferStart != BufferEnd)) || !bComplete;
+		for ( INT i = 0; i < PushedText.Num(); i++ )
+		{
+			if ( PushedText(i).Pos < PushedText(i).Text.Len() )
+			{
+				return true;
+			}
+		}
+		return (BufferStart != BufferEnd) || !bComplete;
 	}
 	//@}
 
@@ -339,12 +478,25 @@ public:
 		return FString();
 	}
 
-	FCharacterProvider(const TCHAR* begin, const TCHAR* end, const FString& file = FString(), INT lineNo = 0)
-	: Input(begin),  Filename(file), InputLine(lineNo)
+	/**
+	* @param	bCopy	whether to keep a copy of the buffer; otherwise it must stay valid and
+	*					unchanged for as long as this provider exists
+	*/
+	FCharacterProvider(const TCHAR* begin, const TCHAR* end, const FString& file = FString(), INT lineNo = 0, UBOOL bCopy = false)
+	: Filename(file), InputLine(lineNo)
 	, InputPos(0), SymbolMap(0), bComplete(false) , macroName_(NAME_None)
 	{
-		BufferStart = *Input;
-		BufferEnd = BufferStart + (end - begin);
+		if ( bCopy )
+		{
+			Input = begin;
+			BufferBegin = *Input;
+		}
+		else
+		{
+			BufferBegin = begin;
+		}
+		BufferStart = BufferBegin;
+		BufferEnd = BufferBegin + (end - begin);
 	}
 
 	~FCharacterProvider()
@@ -379,22 +531,31 @@ private:
 	/** current position of the buffer */
 	INT InputPos;
 
-	/** the buffer for this character provider */
+	/** copy of the buffer for this character provider, for macros whose definition may change while expanded */
 	FString Input;
 
-	/** pointer to the start of the buffer */
+	/** pointer to the first character of the buffer */
+	const TCHAR* BufferBegin;
+
+	/** pointer to the next character of the buffer */
 	const TCHAR* BufferStart;
 
 	/** pointer to the end of the buffer */
 	const TCHAR* BufferEnd;
 
+	/** text injected into the input stream (put back characters, expanded built-in macros), read from Pos onwards */
+	struct FPushedText
+	{
+		FString	Text;
+		INT		Pos;
+	};
+
 	/**
-	* a stack of characters which is always processed before the main input buffer.  Typically
-	* contains characters that have been returned via UngetChar().  Is also used to manually
-	* inject text into the output stream.
-	* (all insertions are reversed so insertion/deletion takes place at the END of the PriorityStack).
+	* a stack of texts which is always processed before the main input buffer, topmost first.
+	* Typically contains characters that have been returned via UngetChar().  Is also used to
+	* manually inject text into the output stream.
 	*/
-	FString PriorityStack;
+	TArray<FPushedText> PushedText;
 	//@}
 
 	/** FALSE if the current position is not at the end of the buffer */
@@ -499,7 +660,7 @@ public:
 	 */
 	void AddMacro(const TCHAR* Macro_BufferStart, const TCHAR* Macro_BufferEnd, const FName& MacroName, FScriptMacroDefinition* MacroDef, TArray<FString>* Values) 
 	{
-		FCharacterProvider* NewProvider = new FCharacterProvider(Macro_BufferStart, Macro_BufferEnd);
+		FCharacterProvider* NewProvider = new FCharacterProvider(Macro_BufferStart, Macro_BufferEnd, FString(), 0, true);
 		if ( NewProvider != NULL )
 		{
 			ProviderStack.AddItem(NewProvider);
@@ -508,6 +669,19 @@ public:
 		}
 	}
 
+	/**
+	 * Add an already expanded macro to the stack of character providers.
+	 *
+	 * @param   ExpandedText		the text to process
+	 * @param   MacroName			the name of the macro that was expanded
+	 */
+	void AddExpandedMacro(const FString& ExpandedText, const FName& MacroName)
+	{
+		FCharacterProvider* NewProvider = new FCharacterProvider(*ExpandedText, *ExpandedText + ExpandedText.Len(), FString(), 0, true);
+		ProviderStack.AddItem(NewProvider);
+		NewProvider->SetMacroName(MacroName);
+	}
+
 	/**
 	 * Returns whether the active provider is a macro.
 	 *
@@ -573,6 +747,20 @@ public:
 		return ProviderStack.Top()->GetChar();
 	}
 
+	/**
+	 * Consumes a run of characters from the currently active provider without copying them; see
+	 * FCharacterProvider::GetSpan.  Returns 0 when the active provider is used up, so that GetChar()
+	 * gets to switch providers.
+	 */
+	INT GetSpan(const TCHAR*& SpanStart, UBOOL (*IsStopChar)(TCHAR))
+	{
+		if ( ProviderStack.Num() == 0 || !(*ProviderStack.Top()) )
+		{
+			return 0;
+		}
+		return ProviderStack.Top()->GetSpan(SpanStart, IsStopChar);
+	}
+
 	/**
 	 * Puts the specified character back into the input buffer, and backs up the position of the input buffer.
 	 *
@@ -759,6 +947,20 @@ public:
 
 	virtual void Process(const TCHAR* Begin, const TCHAR* End, FString& Result);
 
+	/**
+	 * Looks up the result of a previous Process of the same class text in PreprocessCachePath.
+	 * The entry is keyed by a hash of the text, the package and class name and the global symbols,
+	 * and is only accepted if none of the files it included have changed since.
+	 *
+	 * @return	TRUE if Result was restored from the cache
+	 */
+	UBOOL LoadCachedResult(const TCHAR* Begin, const TCHAR* End, FString& Result);
+
+	/**
+	 * Stores the result of Process under the key computed by LoadCachedResult.
+	 */
+	void SaveCachedResult(const FString& Result);
+
 	//virtual FString GetContext();
 
 	/** the character that invokes a macro */
@@ -813,6 +1015,10 @@ public:
 				{
 					definition = Macro;
 					bResult = TRUE;
+					if ( IsVolatileSymbol(macroName) )
+					{
+						bVolatileOutput = TRUE;
+					}
 				}
 			}
 		}
@@ -862,6 +1068,14 @@ public:
 	*/
 	void ExpandMacro(const FName& macroName);
 
+	/**
+	 * Expands a macro from its precompiled segments in one go, instead of pushing its definition
+	 * and parameters through the character stream.
+	 *
+	 * @return	FALSE if the definition or the parameter values need the regular expansion
+	 */
+	UBOOL ExpandCompiledMacro(const FName& macroName, FScriptMacroDefinition& definition, const TArray<FString>& parameters);
+
 	/**
 	 * Returns whether output is currently enabled.  For example, inside of `if(false) blocks, output is disabled.
 	 *
@@ -889,6 +1103,11 @@ public:
 	 */
 	void ProcessIncludeFile( const TCHAR* IncludeFilename, FString* FileContent=NULL );
 
+	/**
+	 * @return	TRUE for global symbols whose value changes between runs (`Date, `Time)
+	 */
+	static UBOOL IsVolatileSymbol( const FName& macroName );
+
 	/**
 	 * Takes an `ifcondition macro condition, and evalutes it to True/False
 	 * NOTE: When parenthesis-enclosed values are encountered: "(True && False) && True"
@@ -923,6 +1142,9 @@ public:
 	static TMap<FName,FScriptMacroDefinition>* GlobalSymbols;
 	static UBOOL bInitializingGlobalSymbols;
 
+	/** `ifcondition expressions evaluated so far, by their macro-expanded text */
+	static TMap<FIfConditionKey,UBOOL> IfConditionResults;
+
 	/** TRUE if this is a shipping package, FALSE if it's a mod package. */
 	UBOOL	bIsShippingPackage;
 
@@ -935,6 +1157,16 @@ public:
 	/** SourcePath * PackageName * "Classes". */
 	FString ClassesPath;
 
+	/** every path probed by `include while processing the class, misses included, for validating the preprocess cache */
+	TArray<FString> IncludedFiles;
+
+	/** TRUE if the output used a symbol that changes between runs, so it mustn't be cached */
+	UBOOL	bVolatileOutput;
+
+	/** preprocess cache entry for this class and the hash of its inputs, set by LoadCachedResult */
+	FString CacheFilename;
+	BYTE	CacheDigest[16];
+
 	/** counter variable map to implement the Counter and SetCounter commands */
 	TMap<FName,INT> ActiveCounters;
 